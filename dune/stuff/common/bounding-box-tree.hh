@@ -0,0 +1,233 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_COMMON_BOUNDING_BOX_TREE_HH
+#define DUNE_STUFF_COMMON_BOUNDING_BOX_TREE_HH
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+
+namespace Dune {
+namespace Stuff {
+namespace Common {
+
+//! An axis aligned box, given by its lower left and upper right corner.
+template <class CoordType, size_t dim>
+struct BoundingBox
+{
+  typedef Dune::FieldVector<CoordType, dim> PointType;
+
+  BoundingBox()
+    : lower_left(std::numeric_limits<CoordType>::max())
+    , upper_right(std::numeric_limits<CoordType>::lowest())
+  {
+  }
+
+  BoundingBox(const PointType& ll, const PointType& ur)
+    : lower_left(ll)
+    , upper_right(ur)
+  {
+  }
+
+  //! enlarges this box to contain other
+  void extend(const BoundingBox& other)
+  {
+    for (size_t dd = 0; dd < dim; ++dd) {
+      lower_left[dd]  = std::min(lower_left[dd], other.lower_left[dd]);
+      upper_right[dd] = std::max(upper_right[dd], other.upper_right[dd]);
+    }
+  }
+
+  //! enlarges this box to contain point
+  void extend(const PointType& point)
+  {
+    for (size_t dd = 0; dd < dim; ++dd) {
+      lower_left[dd]  = std::min(lower_left[dd], point[dd]);
+      upper_right[dd] = std::max(upper_right[dd], point[dd]);
+    }
+  }
+
+  bool contains(const PointType& point) const
+  {
+    for (size_t dd = 0; dd < dim; ++dd)
+      if (point[dd] < lower_left[dd] || point[dd] > upper_right[dd])
+        return false;
+    return true;
+  }
+
+  bool intersects(const BoundingBox& other) const
+  {
+    for (size_t dd = 0; dd < dim; ++dd)
+      if (other.upper_right[dd] < lower_left[dd] || other.lower_left[dd] > upper_right[dd])
+        return false;
+    return true;
+  }
+
+  PointType center() const
+  {
+    PointType ret = lower_left;
+    ret += upper_right;
+    ret *= CoordType(0.5);
+    return ret;
+  }
+
+  PointType lower_left;
+  PointType upper_right;
+}; // struct BoundingBox
+
+/**
+ * \brief A bounding volume hierarchy over a set of axis aligned boxes.
+ *
+ *        The tree is built once (top down, splitting at the median of the box centers along the longest extent) and
+ *        stored in a flat array, the boxes are referred to by their index in the vector given on construction. Queries
+ *        do not allocate (apart from what the given callback does) and are thread safe.
+ */
+template <class CoordType, size_t dim>
+class BoundingBoxTree
+{
+public:
+  typedef BoundingBox<CoordType, dim> BoxType;
+  typedef typename BoxType::PointType PointType;
+
+private:
+  struct Node
+  {
+    BoxType box;
+    size_t begin; // into indices_, first of the boxes of a leaf
+    size_t end;
+    size_t second_child; // the first child of a node is always stored right after it, 0 for leaves
+  };
+
+  // enough for more than 2^60 boxes, since the tree is balanced
+  static const size_t max_depth = 64;
+
+public:
+  explicit BoundingBoxTree(const std::vector<BoxType>& boxes = std::vector<BoxType>(), const size_t leaf_size = 4)
+    : leaf_size_(std::max(leaf_size, size_t(1)))
+  {
+    build(boxes);
+  }
+
+  void build(const std::vector<BoxType>& boxes)
+  {
+    boxes_ = boxes;
+    indices_.resize(boxes_.size());
+    std::iota(indices_.begin(), indices_.end(), size_t(0));
+    nodes_.clear();
+    if (!boxes_.empty()) {
+      nodes_.reserve(2 * (boxes_.size() / leaf_size_ + 1));
+      build(0, boxes_.size());
+    }
+  } // ... build(...)
+
+  size_t size() const { return boxes_.size(); }
+
+  const BoxType& box(const size_t ii) const { return boxes_[ii]; }
+
+  /**
+   * \brief Calls functor(ii) for every box ii which intersects query_box.
+   * \note  The functor may return false to stop the traversal, it has to be convertible to bool.
+   */
+  template <class Functor>
+  void for_each_intersecting(const BoxType& query_box, Functor&& functor) const
+  {
+    traverse([&](const BoxType& node_box) { return node_box.intersects(query_box); }, functor);
+  }
+
+  //! Calls functor(ii) for every box ii which contains point, \sa for_each_intersecting
+  template <class Functor>
+  void for_each_containing(const PointType& point, Functor&& functor) const
+  {
+    traverse([&](const BoxType& node_box) { return node_box.contains(point); }, functor);
+  }
+
+  //! the indices of all boxes intersecting query_box, appended to result
+  void intersecting(const BoxType& query_box, std::vector<size_t>& result) const
+  {
+    for_each_intersecting(query_box, [&](const size_t ii) {
+      result.push_back(ii);
+      return true;
+    });
+  }
+
+private:
+  size_t build(const size_t begin, const size_t end)
+  {
+    const size_t node_index = nodes_.size();
+    nodes_.emplace_back();
+    BoxType box;
+    BoxType centers;
+    for (size_t ii = begin; ii < end; ++ii) {
+      box.extend(boxes_[indices_[ii]]);
+      centers.extend(boxes_[indices_[ii]].center());
+    }
+    nodes_[node_index].box          = box;
+    nodes_[node_index].begin        = begin;
+    nodes_[node_index].end          = end;
+    nodes_[node_index].second_child = 0;
+    if (end - begin <= leaf_size_)
+      return node_index;
+    // split along the longest extent of the centers
+    size_t split_dim = 0;
+    for (size_t dd = 1; dd < dim; ++dd)
+      if (centers.upper_right[dd] - centers.lower_left[dd]
+          > centers.upper_right[split_dim] - centers.lower_left[split_dim])
+        split_dim = dd;
+    const size_t middle = begin + (end - begin) / 2;
+    std::nth_element(indices_.begin() + begin, indices_.begin() + middle, indices_.begin() + end,
+                     [&](const size_t left, const size_t right) {
+                       return boxes_[left].lower_left[split_dim] + boxes_[left].upper_right[split_dim]
+                              < boxes_[right].lower_left[split_dim] + boxes_[right].upper_right[split_dim];
+                     });
+    build(begin, middle);
+    const size_t second_child = build(middle, end);
+    // nodes_ may have been reallocated
+    nodes_[node_index].second_child = second_child;
+    return node_index;
+  } // ... build(...)
+
+  template <class NodePredicate, class Functor>
+  void traverse(const NodePredicate& visit, Functor& functor) const
+  {
+    if (nodes_.empty())
+      return;
+    std::array<size_t, max_depth> stack;
+    size_t stack_size   = 0;
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+      const auto& node = nodes_[stack[--stack_size]];
+      if (!visit(node.box))
+        continue;
+      if (node.second_child == 0) {
+        for (size_t ii = node.begin; ii < node.end; ++ii) {
+          const size_t index = indices_[ii];
+          if (visit(boxes_[index]) && !functor(index))
+            return;
+        }
+      } else {
+        assert(stack_size + 2 <= max_depth);
+        stack[stack_size++] = node.second_child;
+        stack[stack_size++] = size_t(&node - nodes_.data()) + 1;
+      }
+    }
+  } // ... traverse(...)
+
+  size_t leaf_size_;
+  std::vector<BoxType> boxes_;
+  std::vector<size_t> indices_;
+  std::vector<Node> nodes_;
+}; // class BoundingBoxTree
+
+} // namespace Common
+} // namespace Stuff
+} // namespace Dune
+
+#endif // DUNE_STUFF_COMMON_BOUNDING_BOX_TREE_HH
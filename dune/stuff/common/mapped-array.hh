@@ -0,0 +1,218 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_COMMON_MAPPED_ARRAY_HH
+#define DUNE_STUFF_COMMON_MAPPED_ARRAY_HH
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/stuff/common/exceptions.hh>
+
+namespace Dune {
+namespace Stuff {
+namespace Common {
+namespace internal {
+
+struct MappedArrayHeader
+{
+  static const char* magic() { return "DSMAPARR"; }
+  static const std::uint32_t version = 2;
+  static const size_t max_tag_size    = 32;
+
+  char id[8];
+  std::uint32_t format_version;
+  std::uint32_t value_size;
+  std::uint64_t size;
+  char tag[max_tag_size];
+}; // struct MappedArrayHeader
+
+static_assert(sizeof(MappedArrayHeader) == 56, "The binary layout of MappedArrayHeader must not change!");
+
+} // namespace internal
+
+/**
+ * \brief Read-only view of an array of Ts stored in a binary file, which is memory mapped.
+ *
+ *        The file consists of a small header (identifier, format version, sizeof(T), number of entries and a user
+ *        given tag) followed by the raw values. The tag describes the meaning (and version) of the values, e.g.
+ *        "checkerboard.v1", and has to match on reading. Since the file is mapped read-only and shared, all processes
+ *        on a node which map the same file share the same physical pages. Use write() to create such a file.
+ * \note  The file is written and read in native byte order, it is meant as a local cache and not for exchange.
+ */
+template <class T>
+class MappedArray
+{
+  typedef internal::MappedArrayHeader HeaderType;
+  static_assert(std::is_trivially_copyable<T>::value, "T has to be trivially copyable!");
+  static_assert(sizeof(HeaderType) % alignof(T) == 0, "The values would not be properly aligned!");
+
+public:
+  typedef T value_type;
+  typedef const T* const_iterator;
+
+  /**
+   * \brief Writes size values to filename, tagged with tag (at most 32 characters).
+   *
+   *        The values are written to a temporary file first, which is then renamed, so concurrent readers (or writers,
+   *        e.g. several MPI ranks) never see a partially written file.
+   * \return false, if the file could not be written
+   */
+  static bool write(const std::string& filename, const T* values, const size_t size, const std::string& tag = "")
+  {
+    HeaderType header;
+    std::memcpy(header.id, HeaderType::magic(), sizeof(header.id));
+    header.format_version = HeaderType::version;
+    header.value_size     = sizeof(T);
+    header.size           = size;
+    copy_tag(tag, header.tag);
+    const std::string tmp_filename = filename + ".tmp." + std::to_string(::getpid());
+    std::ofstream file(tmp_filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+      return false;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(size * sizeof(T)));
+    file.close();
+    if (!file || std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+      std::remove(tmp_filename.c_str());
+      return false;
+    }
+    return true;
+  } // ... write(...)
+
+  /**
+   * \return true, if filename exists, is tagged with tag and contains at least min_size values of type T
+   * \note   The length of the file is checked against the header as well, so a truncated file (e.g. from a crashed
+   *         or full disk) is reported as invalid and can be rewritten instead of failing later on mapping.
+   */
+  static bool is_valid(const std::string& filename, const size_t min_size = 0, const std::string& tag = "")
+  {
+    struct stat file_stat;
+    if (::stat(filename.c_str(), &file_stat) != 0)
+      return false;
+    std::ifstream file(filename, std::ios::binary);
+    HeaderType header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+      return false;
+    return valid_header(header, tag) && valid_size(header, size_t(file_stat.st_size)) && header.size >= min_size;
+  }
+
+  explicit MappedArray(const std::string& filename, const std::string& tag = "")
+    : filename_(filename)
+    , mapping_(nullptr)
+    , mapping_size_(0)
+    , values_(nullptr)
+    , size_(0)
+  {
+    char expected_tag[HeaderType::max_tag_size];
+    copy_tag(tag, expected_tag); // throws for invalid tags before anything is mapped
+    const int fd = ::open(filename_.c_str(), O_RDONLY);
+    if (fd < 0)
+      DUNE_THROW(IOError, "could not open '" << filename_ << "'!");
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0) {
+      ::close(fd);
+      DUNE_THROW(IOError, "could not stat '" << filename_ << "'!");
+    }
+    if (size_t(file_stat.st_size) < sizeof(HeaderType)) {
+      ::close(fd);
+      DUNE_THROW(Exceptions::wrong_input_given, "'" << filename_ << "' is too small to contain a valid array!");
+    }
+    mapping_size_ = size_t(file_stat.st_size);
+    mapping_      = ::mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping_ == MAP_FAILED) {
+      mapping_ = nullptr;
+      DUNE_THROW(IOError, "could not map '" << filename_ << "'!");
+    }
+    const auto& header = *static_cast<const HeaderType*>(mapping_);
+    if (!valid_header(header, tag) || !valid_size(header, mapping_size_)) {
+      ::munmap(mapping_, mapping_size_);
+      mapping_ = nullptr;
+      DUNE_THROW(Exceptions::wrong_input_given, "'" << filename_ << "' does not contain a valid array!");
+    }
+    size_   = header.size;
+    values_ = reinterpret_cast<const T*>(static_cast<const char*>(mapping_) + sizeof(HeaderType));
+  } // MappedArray(...)
+
+  MappedArray(const MappedArray& other) = delete;
+
+  MappedArray& operator=(const MappedArray& other) = delete;
+
+  ~MappedArray()
+  {
+    if (mapping_)
+      ::munmap(mapping_, mapping_size_);
+  }
+
+  const std::string& filename() const { return filename_; }
+
+  size_t size() const { return size_; }
+
+  const T* data() const { return values_; }
+
+  const T& operator[](const size_t ii) const
+  {
+    assert(ii < size_);
+    return values_[ii];
+  }
+
+  const_iterator begin() const { return values_; }
+
+  const_iterator end() const { return values_ + size_; }
+
+private:
+  static void copy_tag(const std::string& tag, char* ret)
+  {
+    if (tag.size() > HeaderType::max_tag_size)
+      DUNE_THROW(Exceptions::wrong_input_given,
+                 "tag '" << tag << "' is too long (has " << tag.size() << ", may have " << HeaderType::max_tag_size
+                         << " characters)!");
+    std::memset(ret, 0, HeaderType::max_tag_size);
+    std::memcpy(ret, tag.data(), tag.size());
+  }
+
+  static bool valid_header(const HeaderType& header, const std::string& tag)
+  {
+    char expected_tag[HeaderType::max_tag_size];
+    copy_tag(tag, expected_tag);
+    return std::memcmp(header.id, HeaderType::magic(), sizeof(header.id)) == 0
+           && header.format_version == HeaderType::version && header.value_size == sizeof(T)
+           && std::memcmp(header.tag, expected_tag, HeaderType::max_tag_size) == 0;
+  }
+
+  //! the file has to hold exactly the header and header.size values (written to avoid overflows of header.size)
+  static bool valid_size(const HeaderType& header, const size_t file_size)
+  {
+    if (file_size < sizeof(HeaderType) || (file_size - sizeof(HeaderType)) % sizeof(T) != 0)
+      return false;
+    return (file_size - sizeof(HeaderType)) / sizeof(T) == header.size;
+  }
+
+  const std::string filename_;
+  void* mapping_;
+  size_t mapping_size_;
+  const T* values_;
+  size_t size_;
+}; // class MappedArray
+
+} // namespace Common
+} // namespace Stuff
+} // namespace Dune
+
+#endif // DUNE_STUFF_COMMON_MAPPED_ARRAY_HH
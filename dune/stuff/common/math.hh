@@ -20,11 +20,6 @@
 #include <boost/static_assert.hpp>
 #include <boost/fusion/include/void.hpp>
 #include <boost/format.hpp>
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics/stats.hpp>
-#include <boost/accumulators/statistics/max.hpp>
-#include <boost/accumulators/statistics/min.hpp>
-#include <boost/accumulators/statistics/mean.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <dune/stuff/common/reenable_warnings.hh>
 
@@ -102,7 +97,12 @@ typename absretval<T>::type abs(const T& val)
   return absoluteValue<R>::result(static_cast<R>(val));
 }
 
-//! a vector wrapper for continiously updating min,max,avg of some element type vector
+/**
+ * \brief A vector wrapper for continiously updating min,max,avg of some element type vector.
+ *
+ *        Partial results, e.g. computed by several threads, may be combined using operator+=.
+ * \note  average() returns 0 if no element was added.
+ */
 template <class ElementType>
 class MinMaxAvg
 {
@@ -112,27 +112,51 @@ protected:
   typedef MinMaxAvg<ElementType> ThisType;
 
 public:
-  MinMaxAvg() {}
+  MinMaxAvg()
+    : count_(0)
+    , sum_(0)
+    , min_(std::numeric_limits<ElementType>::max())
+    , max_(std::numeric_limits<ElementType>::lowest())
+  {
+  }
 
   template <class stl_container_type>
   MinMaxAvg(const stl_container_type& elements)
+    : MinMaxAvg()
   {
-    static_assert((boost::is_same<ElementType, typename stl_container_type::value_type>::value),
+    static_assert((std::is_same<ElementType, typename stl_container_type::value_type>::value),
                   "cannot assign mismatching types");
-    acc_ = std::for_each(elements.begin(), elements.end(), acc_);
+    for (const auto& element : elements)
+      operator()(element);
   }
 
-  std::size_t count() const { return boost::accumulators::count(acc_); }
-  ElementType sum() const { return boost::accumulators::sum(acc_); }
-  ElementType min() const { return boost::accumulators::min(acc_); }
-  ElementType max() const { return boost::accumulators::max(acc_); }
+  std::size_t count() const { return count_; }
+  ElementType sum() const { return sum_; }
+  ElementType min() const { return min_; }
+  ElementType max() const { return max_; }
   ElementType average() const
   {
     // for integer ElementType this just truncates from floating-point
-    return ElementType(boost::accumulators::mean(acc_));
+    return count_ > 0 ? ElementType(double(sum_) / double(count_)) : ElementType(0);
   }
 
-  void operator()(const ElementType& el) { acc_(el); }
+  void operator()(const ElementType& el)
+  {
+    ++count_;
+    sum_ += el;
+    min_ = std::min(min_, el);
+    max_ = std::max(max_, el);
+  }
+
+  //! combines the elements of other with these
+  ThisType& operator+=(const ThisType& other)
+  {
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    return *this;
+  }
 
   void output(std::ostream& stream)
   {
@@ -140,10 +164,10 @@ public:
   }
 
 protected:
-  typedef boost::accumulators::stats<boost::accumulators::tag::max, boost::accumulators::tag::min,
-                                     boost::accumulators::tag::mean, boost::accumulators::tag::count,
-                                     boost::accumulators::tag::sum> StatsType;
-  boost::accumulators::accumulator_set<ElementType, StatsType> acc_;
+  std::size_t count_;
+  ElementType sum_;
+  ElementType min_;
+  ElementType max_;
 };
 
 //! \return var bounded in [min, max]
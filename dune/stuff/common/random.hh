@@ -6,6 +6,8 @@
 #ifndef DUNE_STUFF_RANDOM_HH
 #define DUNE_STUFF_RANDOM_HH
 
+#include <array>
+#include <cstdint>
 #include <random>
 #include <limits>
 #include <complex>
@@ -64,6 +66,91 @@ struct RNG<std::complex<T>, DistributionImp, EngineImp>
   inline std::complex<T> operator()() { return std::complex<T>(distribution(generator), distribution(generator)); }
 };
 
+/**
+ * \brief Counter-based random number engine (Philox4x32-10, \sa Salmon et al., "Parallel random numbers: as easy as
+ *        1, 2, 3", SC11).
+ *
+ *        Each output block is a bijective function of (seed, stream, position), so any stream (e.g. one per element of
+ *        a random field) can be generated independently of all others, in parallel or on different ranks, with the
+ *        same result as a sequential generation. Streams do not overlap for fewer than 2^66 numbers per stream.
+ *        Satisfies the requirements of a uniform random bit generator and can thus be used with all distributions.
+ */
+class Philox4x32
+{
+public:
+  typedef std::uint32_t result_type;
+  typedef std::array<std::uint32_t, 4> CounterType;
+  typedef std::array<std::uint32_t, 2> KeyType;
+
+  static constexpr result_type min() { return 0; }
+
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+  explicit Philox4x32(const std::uint64_t seed = 0, const std::uint64_t stream = 0)
+    : key_({{std::uint32_t(seed), std::uint32_t(seed >> 32)}})
+    , counter_({{0, 0, std::uint32_t(stream), std::uint32_t(stream >> 32)}})
+    , position_(4)
+  {
+  }
+
+  result_type operator()()
+  {
+    if (position_ == 4) {
+      block_ = block(counter_, key_);
+      // the first two words count the blocks of this stream
+      if (++counter_[0] == 0)
+        ++counter_[1];
+      position_ = 0;
+    }
+    return block_[position_++];
+  }
+
+  void discard(unsigned long long num)
+  {
+    for (; num > 0 && position_ < 4; --num)
+      ++position_;
+    const std::uint64_t blocks = num / 4;
+    const std::uint64_t index  = ((std::uint64_t(counter_[1]) << 32) | counter_[0]) + blocks;
+    counter_[0]                = std::uint32_t(index);
+    counter_[1]                = std::uint32_t(index >> 32);
+    for (num %= 4; num > 0; --num)
+      operator()();
+  } // ... discard(...)
+
+  //! the raw bijection counter -> output for key
+  static CounterType block(CounterType counter, KeyType key)
+  {
+    static const std::uint32_t multipliers[2] = {0xD2511F53, 0xCD9E8D57};
+    static const std::uint32_t weyl[2]        = {0x9E3779B9, 0xBB67AE85};
+    for (size_t round = 0; round < 10; ++round) {
+      if (round > 0) {
+        key[0] += weyl[0];
+        key[1] += weyl[1];
+      }
+      const std::uint64_t product_0 = std::uint64_t(multipliers[0]) * counter[0];
+      const std::uint64_t product_1 = std::uint64_t(multipliers[1]) * counter[2];
+      counter                       = {{std::uint32_t(product_1 >> 32) ^ counter[1] ^ key[0],
+                  std::uint32_t(product_1),
+                  std::uint32_t(product_0 >> 32) ^ counter[3] ^ key[1],
+                  std::uint32_t(product_0)}};
+    }
+    return counter;
+  } // ... block(...)
+
+  bool operator==(const Philox4x32& other) const
+  {
+    return key_ == other.key_ && counter_ == other.counter_ && position_ == other.position_;
+  }
+
+  bool operator!=(const Philox4x32& other) const { return !(*this == other); }
+
+private:
+  KeyType key_;
+  CounterType counter_;
+  CounterType block_;
+  size_t position_;
+}; // class Philox4x32
+
 namespace {
 const std::string alphanums("abcdefghijklmnopqrstuvwxyz"
                             "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
@@ -122,6 +209,24 @@ public:
   }
 };
 
+/**
+ * \brief Uniformly distributed numbers from stream of seed, \sa Philox4x32
+ *
+ *        Use one stream per independent entity (e.g. stream ii for the ii-th element of a random field) to obtain
+ *        results which do not depend on the order of generation.
+ */
+template <class T>
+class CounterBasedRNG : public RNG<T, typename UniformDistributionSelector<T>::type, Philox4x32>
+{
+  typedef RNG<T, typename UniformDistributionSelector<T>::type, Philox4x32> BaseType;
+
+public:
+  CounterBasedRNG(const T min, const T max, const std::uint64_t seed, const std::uint64_t stream = 0)
+    : BaseType(Philox4x32(seed, stream), typename UniformDistributionSelector<T>::type(min, max))
+  {
+  }
+};
+
 template <>
 class DefaultRNG<std::string> : public RandomStrings
 {
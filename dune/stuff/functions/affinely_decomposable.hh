@@ -0,0 +1,297 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_FUNCTIONS_AFFINELY_DECOMPOSABLE_HH
+#define DUNE_STUFF_FUNCTIONS_AFFINELY_DECOMPOSABLE_HH
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <dune/common/dynvector.hh>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/common/memory.hh>
+
+#include "interfaces.hh"
+
+namespace Dune {
+namespace Stuff {
+namespace Functions {
+
+/**
+ * \brief A parametric function f(x; mu) = sum_q theta_q(mu) f_q(x) + f_a(x), which is affine w.r.t. the parameter mu.
+ *
+ *        The components f_q and the optional affine part f_a are stored separately and can be accessed individually, so
+ *        that assemblers can compute their contributions once (offline) and combine these with the coefficients
+ *        theta_q(mu) for each parameter (online), \sa coefficients(). For a direct evaluation, parametrized(mu)
+ *        returns f(.; mu) as a localizable function, which evaluates each component once per point and does not copy
+ *        any component.
+ *
+ * \note  The components have to outlive this function if given by reference.
+ */
+template <class EntityImp, class DomainFieldImp, size_t domainDim, class RangeFieldImp, size_t rangeDim,
+          size_t rangeDimCols = 1>
+class AffinelyDecomposable
+{
+  typedef AffinelyDecomposable<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols> ThisType;
+
+public:
+  typedef LocalizableFunctionInterface<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols>
+      ComponentType;
+  typedef typename ComponentType::EntityType EntityType;
+  typedef typename ComponentType::DomainFieldType DomainFieldType;
+  static const size_t dimDomain = ComponentType::dimDomain;
+  typedef typename ComponentType::DomainType DomainType;
+  typedef typename ComponentType::RangeFieldType RangeFieldType;
+  static const size_t dimRange     = ComponentType::dimRange;
+  static const size_t dimRangeCols = ComponentType::dimRangeCols;
+  typedef typename ComponentType::RangeType RangeType;
+  typedef typename ComponentType::JacobianRangeType JacobianRangeType;
+
+  typedef DynamicVector<double> ParameterType;
+  typedef std::function<RangeFieldType(const ParameterType&)> CoefficientType;
+
+  class Parametrized;
+
+private:
+  class Localfunction : public ComponentType::LocalfunctionType
+  {
+    typedef typename ComponentType::LocalfunctionType BaseType;
+
+  public:
+    Localfunction(const ThisType& function, const std::vector<RangeFieldType>& thetas, const EntityType& ent)
+      : BaseType(ent)
+      , function_(function)
+      , thetas_(thetas)
+      , local_components_(function.num_components())
+    {
+      for (size_t qq = 0; qq < function_.num_components(); ++qq)
+        local_components_[qq] = function_.component(qq).local_function(ent);
+      if (function_.has_affine_part())
+        local_affine_part_ = function_.affine_part().local_function(ent);
+    }
+
+    Localfunction(const Localfunction& /*other*/) = delete;
+
+    Localfunction& operator=(const Localfunction& /*other*/) = delete;
+
+    virtual bool is_bindable() const override final { return true; }
+
+    virtual void bind(const EntityType& ent) override final
+    {
+      this->bind_entity(ent);
+      for (size_t qq = 0; qq < function_.num_components(); ++qq)
+        function_.component(qq).bind_local_function(local_components_[qq], ent);
+      if (function_.has_affine_part())
+        function_.affine_part().bind_local_function(local_affine_part_, ent);
+    }
+
+    virtual size_t order() const override final
+    {
+      size_t ret = local_affine_part_ ? local_affine_part_->order() : 0;
+      for (const auto& local_component : local_components_)
+        ret = std::max(ret, local_component->order());
+      return ret;
+    }
+
+    virtual void evaluate(const DomainType& xx, RangeType& ret) const override final
+    {
+      assert(this->is_a_valid_point(xx));
+      if (local_affine_part_)
+        local_affine_part_->evaluate(xx, ret);
+      else
+        ret = RangeFieldType(0);
+      for (size_t qq = 0; qq < local_components_.size(); ++qq) {
+        local_components_[qq]->evaluate(xx, tmp_value_);
+        ret.axpy(thetas_[qq], tmp_value_);
+      }
+    } // ... evaluate(...)
+
+    virtual void jacobian(const DomainType& xx, JacobianRangeType& ret) const override final
+    {
+      assert(this->is_a_valid_point(xx));
+      if (local_affine_part_)
+        local_affine_part_->jacobian(xx, ret);
+      else
+        clear(ret, internal::ChooseVariant<dimRangeCols>());
+      for (size_t qq = 0; qq < local_components_.size(); ++qq) {
+        local_components_[qq]->jacobian(xx, tmp_jacobian_);
+        axpy(ret, thetas_[qq], tmp_jacobian_, internal::ChooseVariant<dimRangeCols>());
+      }
+    } // ... jacobian(...)
+
+  private:
+    template <size_t rC>
+    static void clear(JacobianRangeType& ret, internal::ChooseVariant<rC>)
+    {
+      for (size_t cc = 0; cc < rC; ++cc)
+        ret[cc] = RangeFieldType(0);
+    }
+
+    static void clear(JacobianRangeType& ret, internal::ChooseVariant<1>) { ret = RangeFieldType(0); }
+
+    template <size_t rC>
+    static void axpy(JacobianRangeType& ret, const RangeFieldType& alpha, const JacobianRangeType& xx,
+                     internal::ChooseVariant<rC>)
+    {
+      for (size_t cc = 0; cc < rC; ++cc)
+        ret[cc].axpy(alpha, xx[cc]);
+    }
+
+    static void axpy(JacobianRangeType& ret, const RangeFieldType& alpha, const JacobianRangeType& xx,
+                     internal::ChooseVariant<1>)
+    {
+      ret.axpy(alpha, xx);
+    }
+
+    const ThisType& function_;
+    const std::vector<RangeFieldType>& thetas_;
+    std::vector<std::unique_ptr<typename ComponentType::LocalfunctionType>> local_components_;
+    std::unique_ptr<typename ComponentType::LocalfunctionType> local_affine_part_;
+    mutable RangeType tmp_value_;
+    mutable JacobianRangeType tmp_jacobian_;
+  }; // class Localfunction
+
+public:
+  /**
+   * \brief f(.; mu) for a fixed parameter mu.
+   * \note  Refers to the AffinelyDecomposable it was created from, which has to outlive it.
+   */
+  class Parametrized : public ComponentType
+  {
+  public:
+    typedef typename ComponentType::LocalfunctionType LocalfunctionType;
+
+    Parametrized(const ThisType& function, const ParameterType& mu)
+      : function_(function)
+      , mu_(mu)
+      , thetas_(function.coefficients(mu))
+    {
+    }
+
+    const ParameterType& parameter() const { return mu_; }
+
+    //! the coefficients theta_q(mu)
+    const std::vector<RangeFieldType>& coefficients() const { return thetas_; }
+
+    virtual std::unique_ptr<LocalfunctionType> local_function(const EntityType& entity) const override final
+    {
+      return Common::make_unique<Localfunction>(function_, thetas_, entity);
+    }
+
+    virtual std::string type() const override final { return ThisType::static_id() + ".parametrized"; }
+
+    virtual std::string name() const override final { return function_.name(); }
+
+  private:
+    const ThisType& function_;
+    const ParameterType mu_;
+    const std::vector<RangeFieldType> thetas_;
+  }; // class Parametrized
+
+  static std::string static_id() { return ComponentType::static_id() + ".affinelydecomposable"; }
+
+  //! \param parameter_size the number of entries of each parameter mu
+  explicit AffinelyDecomposable(const size_t parameter_size, const std::string nm = static_id())
+    : parameter_size_(parameter_size)
+    , name_(nm)
+  {
+  }
+
+  AffinelyDecomposable(const ThisType& other) = delete;
+
+  ThisType& operator=(const ThisType& other) = delete;
+
+  std::string name() const { return name_; }
+
+  size_t parameter_size() const { return parameter_size_; }
+
+  //! adds theta(mu) * component(x)
+  void register_component(const ComponentType& component, const CoefficientType& theta)
+  {
+    components_.emplace_back(component);
+    coefficients_.emplace_back(theta);
+  }
+
+  void register_component(std::shared_ptr<const ComponentType> component, const CoefficientType& theta)
+  {
+    components_.emplace_back(component);
+    coefficients_.emplace_back(theta);
+  }
+
+  //! adds the parameter independent affine_part(x), at most once
+  void register_affine_part(const ComponentType& affine_part)
+  {
+    if (has_affine_part())
+      DUNE_THROW(Exceptions::you_are_using_this_wrong, "There already is an affine part!");
+    affine_part_ = Common::make_unique<Common::ConstStorageProvider<ComponentType>>(affine_part);
+  }
+
+  void register_affine_part(std::shared_ptr<const ComponentType> affine_part)
+  {
+    if (has_affine_part())
+      DUNE_THROW(Exceptions::you_are_using_this_wrong, "There already is an affine part!");
+    affine_part_ = Common::make_unique<Common::ConstStorageProvider<ComponentType>>(affine_part);
+  }
+
+  size_t num_components() const { return components_.size(); }
+
+  const ComponentType& component(const size_t qq) const
+  {
+    if (qq >= num_components())
+      DUNE_THROW(Exceptions::index_out_of_range,
+                 "There are only " << num_components() << " components (requested " << qq << ")!");
+    return components_[qq].access();
+  }
+
+  const CoefficientType& coefficient(const size_t qq) const
+  {
+    if (qq >= num_components())
+      DUNE_THROW(Exceptions::index_out_of_range,
+                 "There are only " << num_components() << " components (requested " << qq << ")!");
+    return coefficients_[qq];
+  }
+
+  bool has_affine_part() const { return bool(affine_part_); }
+
+  const ComponentType& affine_part() const
+  {
+    if (!has_affine_part())
+      DUNE_THROW(Exceptions::you_are_using_this_wrong, "There is no affine part!");
+    return affine_part_->access();
+  }
+
+  //! the coefficients theta_q(mu) of all components
+  std::vector<RangeFieldType> coefficients(const ParameterType& mu) const
+  {
+    if (mu.size() != parameter_size_)
+      DUNE_THROW(Exceptions::wrong_input_given,
+                 "The parameter has to have " << parameter_size_ << " entries (has " << mu.size() << ")!");
+    std::vector<RangeFieldType> ret(num_components());
+    for (size_t qq = 0; qq < num_components(); ++qq)
+      ret[qq] = coefficients_[qq](mu);
+    return ret;
+  } // ... coefficients(...)
+
+  //! f(.; mu), \sa Parametrized
+  Parametrized parametrized(const ParameterType& mu) const { return Parametrized(*this, mu); }
+
+private:
+  const size_t parameter_size_;
+  const std::string name_;
+  std::deque<Common::ConstStorageProvider<ComponentType>> components_;
+  std::vector<CoefficientType> coefficients_;
+  std::unique_ptr<Common::ConstStorageProvider<ComponentType>> affine_part_;
+}; // class AffinelyDecomposable
+
+} // namespace Functions
+} // namespace Stuff
+} // namespace Dune
+
+#endif // DUNE_STUFF_FUNCTIONS_AFFINELY_DECOMPOSABLE_HH
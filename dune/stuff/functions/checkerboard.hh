@@ -6,30 +6,185 @@
 #ifndef DUNE_STUFF_FUNCTION_CHECKERBOARD_HH
 #define DUNE_STUFF_FUNCTION_CHECKERBOARD_HH
 
+#include <array>
 #include <vector>
 #include <cmath>
 #include <memory>
+#include <type_traits>
 
 #include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
 
 #include <dune/stuff/common/configuration.hh>
 #include <dune/stuff/common/debug.hh>
+#include <dune/stuff/common/exceptions.hh>
 #include <dune/stuff/common/fvector.hh>
+#include <dune/stuff/common/mapped-array.hh>
 
 #include "interfaces.hh"
 
 namespace Dune {
 namespace Stuff {
 namespace Functions {
+namespace internal {
 
+// uniform access to the entries of vector and matrix valued ranges
+template <class K, int SIZE>
+K& range_entry(FieldVector<K, SIZE>& value, const size_t ii, const size_t /*jj*/)
+{
+  return value[ii];
+}
+
+template <class K, int SIZE>
+const K& range_entry(const FieldVector<K, SIZE>& value, const size_t ii, const size_t /*jj*/)
+{
+  return value[ii];
+}
+
+template <class K, int ROWS, int COLS>
+K& range_entry(FieldMatrix<K, ROWS, COLS>& value, const size_t ii, const size_t jj)
+{
+  return value[ii][jj];
+}
+
+template <class K, int ROWS, int COLS>
+const K& range_entry(const FieldMatrix<K, ROWS, COLS>& value, const size_t ii, const size_t jj)
+{
+  return value[ii][jj];
+}
+
+template <class K, size_t r, size_t rC>
+struct CheckerboardRangeType
+{
+  typedef typename std::conditional<rC == 1, FieldVector<K, r>, FieldMatrix<K, r, rC>>::type type;
+};
+
+} // namespace internal
+
+/**
+ * \brief Storage policies for the cell values of a Checkerboard.
+ *
+ *        Each policy defines the StoredType of one cell value, compress() to convert a RangeType into it (throwing
+ *        Exceptions::wrong_input_given if the value can not be represented), expand() to convert it back and
+ *        from_scalar() for values given as a single number (as in Checkerboard::create). StoredFieldImp may be chosen
+ *        as float to halve the memory (and bandwidth) at the cost of precision.
+ */
+namespace CheckerboardStorage {
+
+//! stores all r*rC entries of each value, the default
+template <class RangeFieldImp, size_t rangeDim, size_t rangeDimCols, class StoredFieldImp = RangeFieldImp>
+struct Full
+{
+  typedef typename internal::CheckerboardRangeType<RangeFieldImp, rangeDim, rangeDimCols>::type RangeType;
+  typedef typename internal::CheckerboardRangeType<StoredFieldImp, rangeDim, rangeDimCols>::type StoredType;
+
+  static StoredType compress(const RangeType& value)
+  {
+    StoredType ret;
+    for (size_t ii = 0; ii < rangeDim; ++ii)
+      for (size_t jj = 0; jj < rangeDimCols; ++jj)
+        internal::range_entry(ret, ii, jj) = StoredFieldImp(internal::range_entry(value, ii, jj));
+    return ret;
+  }
+
+  static void expand(const StoredType& stored, RangeType& ret)
+  {
+    for (size_t ii = 0; ii < rangeDim; ++ii)
+      for (size_t jj = 0; jj < rangeDimCols; ++jj)
+        internal::range_entry(ret, ii, jj) = RangeFieldImp(internal::range_entry(stored, ii, jj));
+  }
+
+  //! all entries are set to value
+  static StoredType from_scalar(const RangeFieldImp& value) { return StoredType(StoredFieldImp(value)); }
+}; // struct Full
+
+//! stores a single number s per value, which represents s times the identity
+template <class RangeFieldImp, size_t rangeDim, size_t rangeDimCols, class StoredFieldImp = RangeFieldImp>
+struct ScalarTimesIdentity
+{
+  static_assert(rangeDim == rangeDimCols || (rangeDim == 1 && rangeDimCols == 1), "Only available for square ranges!");
+
+  typedef typename internal::CheckerboardRangeType<RangeFieldImp, rangeDim, rangeDimCols>::type RangeType;
+  typedef StoredFieldImp StoredType;
+
+  static StoredType compress(const RangeType& value)
+  {
+    const RangeFieldImp scalar = internal::range_entry(value, 0, 0);
+    for (size_t ii = 0; ii < rangeDim; ++ii)
+      for (size_t jj = 0; jj < rangeDimCols; ++jj)
+        if (internal::range_entry(value, ii, jj) != (ii == jj ? scalar : RangeFieldImp(0)))
+          DUNE_THROW(Exceptions::wrong_input_given, "value is not a multiple of the identity:\n" << value);
+    return StoredType(scalar);
+  }
+
+  static void expand(const StoredType& stored, RangeType& ret)
+  {
+    ret = RangeFieldImp(0);
+    for (size_t ii = 0; ii < rangeDim; ++ii)
+      internal::range_entry(ret, ii, ii) = RangeFieldImp(stored);
+  }
+
+  static StoredType from_scalar(const RangeFieldImp& value) { return StoredType(value); }
+}; // struct ScalarTimesIdentity
+
+//! stores the diagonal of each value
+template <class RangeFieldImp, size_t rangeDim, size_t rangeDimCols, class StoredFieldImp = RangeFieldImp>
+struct Diagonal
+{
+  static_assert(rangeDim == rangeDimCols || (rangeDim == 1 && rangeDimCols == 1), "Only available for square ranges!");
+
+  typedef typename internal::CheckerboardRangeType<RangeFieldImp, rangeDim, rangeDimCols>::type RangeType;
+  typedef std::array<StoredFieldImp, rangeDim> StoredType;
+
+  static StoredType compress(const RangeType& value)
+  {
+    StoredType ret;
+    for (size_t ii = 0; ii < rangeDim; ++ii) {
+      for (size_t jj = 0; jj < rangeDimCols; ++jj)
+        if (ii != jj && internal::range_entry(value, ii, jj) != RangeFieldImp(0))
+          DUNE_THROW(Exceptions::wrong_input_given, "value is not diagonal:\n" << value);
+      ret[ii] = StoredFieldImp(internal::range_entry(value, ii, ii));
+    }
+    return ret;
+  }
+
+  static void expand(const StoredType& stored, RangeType& ret)
+  {
+    ret = RangeFieldImp(0);
+    for (size_t ii = 0; ii < rangeDim; ++ii)
+      internal::range_entry(ret, ii, ii) = RangeFieldImp(stored[ii]);
+  }
+
+  //! value times the identity
+  static StoredType from_scalar(const RangeFieldImp& value)
+  {
+    StoredType ret;
+    ret.fill(StoredFieldImp(value));
+    return ret;
+  }
+}; // struct Diagonal
+
+} // namespace CheckerboardStorage
+
+/**
+ * \brief A function which is constant on each cell of an equidistant partition of a cube.
+ * \note  The values are stored as given by StorageImp, \sa CheckerboardStorage. They are expanded to RangeType once per
+ *        entity when a local function is bound, so the chosen storage does not affect the cost of evaluations.
+ */
 template <class EntityImp, class DomainFieldImp, size_t domainDim, class RangeFieldImp, size_t rangeDim,
-          size_t rangeDimCols = 1>
+          size_t rangeDimCols = 1,
+          class StorageImp = CheckerboardStorage::Full<RangeFieldImp, rangeDim, rangeDimCols>>
 class Checkerboard
     : public LocalizableFunctionInterface<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols>
 {
   typedef LocalizableFunctionInterface<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols>
       BaseType;
-  typedef Checkerboard<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols> ThisType;
+  typedef Checkerboard<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols, StorageImp>
+      ThisType;
+
+  static_assert(std::is_same<typename StorageImp::RangeType, typename BaseType::RangeType>::value,
+                "StorageImp does not match the range of this function!");
 
   class Localfunction
       : public LocalfunctionInterface<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols>
@@ -45,12 +200,23 @@ class Checkerboard
     typedef typename BaseType::RangeType RangeType;
     typedef typename BaseType::JacobianRangeType JacobianRangeType;
 
-    Localfunction(const EntityType& ent, const RangeType value) : BaseType(ent), value_(value) {}
+    Localfunction(const EntityType& ent, const ThisType& function)
+      : BaseType(ent), function_(function), value_(function_.value(ent))
+    {
+    }
 
     Localfunction(const Localfunction& /*other*/) = delete;
 
     Localfunction& operator=(const Localfunction& /*other*/) = delete;
 
+    virtual bool is_bindable() const override final { return true; }
+
+    virtual void bind(const EntityType& ent) override final
+    {
+      this->bind_entity(ent);
+      value_ = function_.value(ent);
+    }
+
     virtual size_t order() const override { return 0; }
 
     virtual void evaluate(const DomainType& UNUSED_UNLESS_DEBUG(xx), RangeType& ret) const override
@@ -75,7 +241,9 @@ class Checkerboard
     }
 
     void jacobian_helper(JacobianRangeType& ret, internal::ChooseVariant<1>) const { ret *= RangeFieldType(0); }
-    const RangeType value_;
+
+    const ThisType& function_;
+    RangeType value_;
   }; // class Localfunction
 
 public:
@@ -88,6 +256,9 @@ public:
   typedef typename BaseType::RangeFieldType RangeFieldType;
   typedef typename BaseType::RangeType RangeType;
 
+  typedef StorageImp StorageType;
+  typedef typename StorageType::StoredType StoredType;
+
   static const bool available = true;
 
   static std::string static_id() { return BaseType::static_id() + ".checkerboard"; }
@@ -121,10 +292,10 @@ public:
     size_t num_values = 1;
     for (size_t ii = 0; ii < num_elements.size(); ++ii)
       num_values *= num_elements[ii];
-    std::vector<RangeType> values(num_values);
     auto values_rf = cfg.get("values", default_cfg.get<std::vector<RangeFieldType>>("values"), num_values);
+    auto values    = std::make_shared<std::vector<StoredType>>(values_rf.size());
     for (size_t ii = 0; ii < values_rf.size(); ++ii)
-      values[ii] = RangeType(values_rf[ii]);
+      (*values)[ii] = StorageType::from_scalar(values_rf[ii]);
     // create
     return Common::make_unique<ThisType>(
         cfg.get(
@@ -143,23 +314,25 @@ public:
     : lowerLeft_(new Common::FieldVector<DomainFieldType, dimDomain>(lowerLeft))
     , upperRight_(new Common::FieldVector<DomainFieldType, dimDomain>(upperRight))
     , numElements_(new Common::FieldVector<size_t, dimDomain>(numElements))
-    , values_(new std::vector<RangeType>(values))
+    , values_(compress(values))
     , name_(nm)
   {
-    // checks
-    size_t totalSubdomains = 1;
-    for (size_t dd = 0; dd < dimDomain; ++dd) {
-      const auto& ll = (*lowerLeft_)[dd];
-      const auto& ur = (*upperRight_)[dd];
-      const auto& ne = (*numElements_)[dd];
-      if (!(ll < ur))
-        DUNE_THROW(Dune::RangeError, "lowerLeft has to be elementwise smaller than upperRight!");
-      totalSubdomains *= ne;
-    }
-    if (values_->size() < totalSubdomains)
-      DUNE_THROW(Dune::RangeError,
-                 "values too small (is " << values_->size() << ", should be " << totalSubdomains << ")");
-  } // Checkerboard(...)
+    check();
+  }
+
+  //! uses the already compressed values, which may be shared with other functions, \sa CheckerboardStorage
+  Checkerboard(const Common::FieldVector<DomainFieldType, dimDomain>& lowerLeft,
+               const Common::FieldVector<DomainFieldType, dimDomain>& upperRight,
+               const Common::FieldVector<size_t, dimDomain>& numElements,
+               std::shared_ptr<const std::vector<StoredType>> values, const std::string nm = static_id())
+    : lowerLeft_(new Common::FieldVector<DomainFieldType, dimDomain>(lowerLeft))
+    , upperRight_(new Common::FieldVector<DomainFieldType, dimDomain>(upperRight))
+    , numElements_(new Common::FieldVector<size_t, dimDomain>(numElements))
+    , values_(values)
+    , name_(nm)
+  {
+    check();
+  }
 
   Checkerboard(const ThisType& other) = default;
 
@@ -167,43 +340,202 @@ public:
 
   ThisType& operator=(ThisType&& source) = delete;
 
+  /**
+   * \brief Creates a checkerboard with the values stored in filename, \sa save
+   * \note  The values are read from a memory mapped file and the number of values has to match numElements exactly.
+   */
+  static std::unique_ptr<ThisType> load(const std::string& filename,
+                                        const Common::FieldVector<DomainFieldType, dimDomain>& lowerLeft,
+                                        const Common::FieldVector<DomainFieldType, dimDomain>& upperRight,
+                                        const Common::FieldVector<size_t, dimDomain>& numElements,
+                                        const std::string nm = static_id())
+  {
+    const Common::MappedArray<RangeFieldType> mapped(filename, snapshot_tag());
+    size_t num_values = rangeDim * rangeDimCols;
+    for (size_t dd = 0; dd < dimDomain; ++dd)
+      num_values *= numElements[dd];
+    if (mapped.size() != num_values)
+      DUNE_THROW(Exceptions::wrong_input_given,
+                 "'" << filename << "' does not contain a valid number of values (is " << mapped.size()
+                     << ", should be "
+                     << num_values
+                     << ")!");
+    auto values = std::make_shared<std::vector<StoredType>>(mapped.size() / (rangeDim * rangeDimCols));
+    RangeType value;
+    for (size_t ii = 0; ii < values->size(); ++ii) {
+      unflatten(mapped.data() + ii * rangeDim * rangeDimCols, value);
+      (*values)[ii] = StorageType::compress(value);
+    }
+    return Common::make_unique<ThisType>(lowerLeft, upperRight, numElements, std::move(values), nm);
+  } // ... load(...)
+
+  /**
+   * \brief Writes the values to filename (in a versioned binary format in native byte order), \sa load
+   * \note  Only the values of the numElements cells are written, surplus values are dropped.
+   * \return false, if the file could not be written
+   */
+  bool save(const std::string& filename) const
+  {
+    const size_t num_cells = num_subdomains();
+    std::vector<RangeFieldType> flat_values(num_cells * rangeDim * rangeDimCols);
+    RangeType value;
+    for (size_t ii = 0; ii < num_cells; ++ii) {
+      StorageType::expand((*values_)[ii], value);
+      flatten(value, flat_values.data() + ii * rangeDim * rangeDimCols);
+    }
+    return Common::MappedArray<RangeFieldType>::write(filename, flat_values.data(), flat_values.size(), snapshot_tag());
+  }
+
   virtual std::string type() const override { return BaseType::static_id() + ".checkerboard"; }
 
   virtual std::string name() const override { return name_; }
 
   virtual std::unique_ptr<LocalfunctionType> local_function(const EntityType& entity) const override
+  {
+    return Common::make_unique<Localfunction>(entity, *this);
+  }
+
+  //! index of the cell the center of entity belongs to (in the ordering of values)
+  size_t subdomain(const EntityType& entity) const
   {
     // decide on the subdomain the center of the entity belongs to
     const auto center = entity.geometry().center();
-    std::vector<size_t> whichPartition(dimDomain, 0);
-    const auto& ll = *lowerLeft_;
-    const auto& ur = *upperRight_;
-    const auto& ne = *numElements_;
-    for (size_t dd = 0; dd < dimDomain; ++dd) {
+    const auto& ll    = *lowerLeft_;
+    const auto& ur    = *upperRight_;
+    const auto& ne    = *numElements_;
+    size_t subdomain  = 0;
+    size_t stride     = 1;
+    for (size_t dd = 0; dd < std::min(dimDomain, size_t(3)); ++dd) {
       // for points that are on upperRight_[d], this selects one partition too much
       // so we need to cap this
-      whichPartition[dd] =
+      const size_t which_partition =
           std::min(size_t(std::floor(ne[dd] * ((center[dd] - ll[dd]) / (ur[dd] - ll[dd])))), ne[dd] - 1);
+      subdomain += which_partition * stride;
+      stride *= ne[dd];
     }
-    size_t subdomain = 0;
-    if (dimDomain == 1)
-      subdomain = whichPartition[0];
-    else if (dimDomain == 2)
-      subdomain = whichPartition[0] + whichPartition[1] * ne[0];
-    else
-      subdomain = whichPartition[0] + whichPartition[1] * ne[0] + whichPartition[2] * ne[1] * ne[0];
-    // return the component that belongs to the subdomain
-    return std::unique_ptr<Localfunction>(new Localfunction(entity, (*values_)[subdomain]));
-  } // ... local_function(...)
+    return subdomain;
+  } // ... subdomain(...)
+
+  //! value of the cell the center of entity belongs to
+  RangeType value(const EntityType& entity) const
+  {
+    RangeType ret;
+    StorageType::expand((*values_)[subdomain(entity)], ret);
+    return ret;
+  }
+
+  //! the values of all cells, as stored by StorageType
+  const std::vector<StoredType>& stored_values() const { return *values_; }
 
 private:
+  // increase the version whenever the layout of the values changes
+  static std::string snapshot_tag()
+  {
+    return "checkerboard.v1." + std::to_string(rangeDim) + "x" + std::to_string(rangeDimCols);
+  }
+
+  size_t num_subdomains() const
+  {
+    size_t ret = 1;
+    for (size_t dd = 0; dd < dimDomain; ++dd)
+      ret *= (*numElements_)[dd];
+    return ret;
+  }
+
+  void check() const
+  {
+    for (size_t dd = 0; dd < dimDomain; ++dd) {
+      const auto& ll = (*lowerLeft_)[dd];
+      const auto& ur = (*upperRight_)[dd];
+      if (!(ll < ur))
+        DUNE_THROW(Dune::RangeError, "lowerLeft has to be elementwise smaller than upperRight!");
+    }
+    const size_t totalSubdomains = num_subdomains();
+    if (values_->size() < totalSubdomains)
+      DUNE_THROW(Dune::RangeError,
+                 "values too small (is " << values_->size() << ", should be " << totalSubdomains << ")");
+  } // ... check(...)
+
+  static std::shared_ptr<const std::vector<StoredType>> compress(const std::vector<RangeType>& values)
+  {
+    auto ret = std::make_shared<std::vector<StoredType>>(values.size());
+    for (size_t ii = 0; ii < values.size(); ++ii)
+      (*ret)[ii] = StorageType::compress(values[ii]);
+    return ret;
+  }
+
+  static void flatten(const RangeType& value, RangeFieldType* ret)
+  {
+    for (size_t ii = 0; ii < rangeDim; ++ii)
+      for (size_t jj = 0; jj < rangeDimCols; ++jj)
+        ret[ii * rangeDimCols + jj] = internal::range_entry(value, ii, jj);
+  }
+
+  static void unflatten(const RangeFieldType* values, RangeType& ret)
+  {
+    for (size_t ii = 0; ii < rangeDim; ++ii)
+      for (size_t jj = 0; jj < rangeDimCols; ++jj)
+        internal::range_entry(ret, ii, jj) = values[ii * rangeDimCols + jj];
+  }
+
   std::shared_ptr<const Common::FieldVector<DomainFieldType, dimDomain>> lowerLeft_;
   std::shared_ptr<const Common::FieldVector<DomainFieldType, dimDomain>> upperRight_;
   std::shared_ptr<const Common::FieldVector<size_t, dimDomain>> numElements_;
-  std::shared_ptr<const std::vector<RangeType>> values_;
+  std::shared_ptr<const std::vector<StoredType>> values_;
   std::string name_;
 }; // class Checkerboard
 
+namespace internal {
+
+//! Evaluates to the value of the checkerboard on the entity without any allocation, \sa FusedLocalfunction
+template <class FunctionType>
+class FusedLocalfunction<
+    FunctionType,
+    typename std::enable_if<std::is_base_of<
+        Checkerboard<typename FunctionType::EntityType, typename FunctionType::DomainFieldType, FunctionType::dimDomain,
+                     typename FunctionType::RangeFieldType, FunctionType::dimRange, FunctionType::dimRangeCols,
+                     typename FunctionType::StorageType>,
+        FunctionType>::value>::type>
+{
+public:
+  typedef typename FunctionType::EntityType EntityType;
+  typedef typename FunctionType::DomainType DomainType;
+  typedef typename FunctionType::RangeFieldType RangeFieldType;
+  typedef typename FunctionType::RangeType RangeType;
+  typedef typename FunctionType::JacobianRangeType JacobianRangeType;
+
+  FusedLocalfunction(const FunctionType& function, const EntityType& ent)
+    : function_(function)
+    , value_(function_.value(ent))
+  {
+  }
+
+  void bind(const EntityType& ent) { value_ = function_.value(ent); }
+
+  size_t order() const { return 0; }
+
+  void evaluate(const DomainType& /*xx*/, RangeType& ret) const { ret = value_; }
+
+  void jacobian(const DomainType& /*xx*/, JacobianRangeType& ret) const
+  {
+    jacobian_helper(ret, ChooseVariant<FunctionType::dimRangeCols>());
+  }
+
+private:
+  template <size_t rC>
+  void jacobian_helper(JacobianRangeType& ret, ChooseVariant<rC>) const
+  {
+    for (auto& col_jacobian : ret)
+      col_jacobian *= RangeFieldType(0);
+  }
+
+  void jacobian_helper(JacobianRangeType& ret, ChooseVariant<1>) const { ret *= RangeFieldType(0); }
+
+  const FunctionType& function_;
+  RangeType value_;
+}; // class FusedLocalfunction< checkerboard >
+
+} // namespace internal
 } // namespace Functions
 } // namespace Stuff
 } // namespace Dune
@@ -115,16 +115,18 @@ private:
 
     static size_t order(const size_t left_order, const size_t right_order) { return std::max(left_order, right_order); }
 
-    static void evaluate(const LeftLocalfunctionType& left_local, const RightLocalfunctionType& right_local,
-                         const DomainType& xx, RangeType& ret, RangeType& tmp_ret)
+    template <class LeftLocalType, class RightLocalType>
+    static void evaluate(const LeftLocalType& left_local, const RightLocalType& right_local, const DomainType& xx,
+                         RangeType& ret, RangeType& tmp_ret)
     {
       left_local.evaluate(xx, ret);
       right_local.evaluate(xx, tmp_ret);
       ret -= tmp_ret;
     } // ... evaluate(...)
 
-    static void jacobian(const LeftLocalfunctionType& left_local, const RightLocalfunctionType& right_local,
-                         const DomainType& xx, JacobianRangeType& ret, JacobianRangeType& tmp_ret)
+    template <class LeftLocalType, class RightLocalType>
+    static void jacobian(const LeftLocalType& left_local, const RightLocalType& right_local, const DomainType& xx,
+                         JacobianRangeType& ret, JacobianRangeType& tmp_ret)
     {
       left_local.jacobian(xx, ret);
       right_local.jacobian(xx, tmp_ret);
@@ -140,16 +142,18 @@ private:
 
     static size_t order(const size_t left_order, const size_t right_order) { return std::max(left_order, right_order); }
 
-    static void evaluate(const LeftLocalfunctionType& left_local, const RightLocalfunctionType& right_local,
-                         const DomainType& xx, RangeType& ret, RangeType& tmp_ret)
+    template <class LeftLocalType, class RightLocalType>
+    static void evaluate(const LeftLocalType& left_local, const RightLocalType& right_local, const DomainType& xx,
+                         RangeType& ret, RangeType& tmp_ret)
     {
       left_local.evaluate(xx, ret);
       right_local.evaluate(xx, tmp_ret);
       ret += tmp_ret;
     } // ... evaluate(...)
 
-    static void jacobian(const LeftLocalfunctionType& left_local, const RightLocalfunctionType& right_local,
-                         const DomainType& xx, JacobianRangeType& ret, JacobianRangeType& tmp_ret)
+    template <class LeftLocalType, class RightLocalType>
+    static void jacobian(const LeftLocalType& left_local, const RightLocalType& right_local, const DomainType& xx,
+                         JacobianRangeType& ret, JacobianRangeType& tmp_ret)
     {
       left_local.jacobian(xx, ret);
       right_local.jacobian(xx, tmp_ret);
@@ -166,15 +170,18 @@ private:
 
     static size_t order(const size_t left_order, const size_t right_order) { return left_order + right_order; }
 
-    static void evaluate(const LeftLocalfunctionType& left_local, const RightLocalfunctionType& right_local,
-                         const DomainType& xx, RangeType& ret, RangeType& /*tmp_ret*/)
+    template <class LeftLocalType, class RightLocalType>
+    static void evaluate(const LeftLocalType& left_local, const RightLocalType& right_local, const DomainType& xx,
+                         RangeType& ret, RangeType& /*tmp_ret*/)
     {
-      auto left_value = left_local.evaluate(xx);
+      typename LeftType::RangeType left_value(0);
+      left_local.evaluate(xx, left_value);
       right_local.evaluate(xx, ret);
-      ret *= left_value;
+      ret *= left_value[0];
     } // ... evaluate(...)
 
-    static void jacobian(const LeftLocalfunctionType& /*left_local*/, const RightLocalfunctionType& /*right_local*/,
+    template <class LeftLocalType, class RightLocalType>
+    static void jacobian(const LeftLocalType& /*left_local*/, const RightLocalType& /*right_local*/,
                          const DomainType& /*xx*/, JacobianRangeType& /*ret*/, JacobianRangeType& /*tmp_ret*/)
     {
       DUNE_THROW(NotImplemented, "If you need this, implement it!");
@@ -189,22 +196,170 @@ public:
     return Call<comb>::order(left_order, right_order);
   }
 
-  static void evaluate(const LeftLocalfunctionType& left_local, const RightLocalfunctionType& right_local,
-                       const DomainType& xx, RangeType& ret, RangeType& tmp_ret)
+  template <class LeftLocalType, class RightLocalType>
+  static void evaluate(const LeftLocalType& left_local, const RightLocalType& right_local, const DomainType& xx,
+                       RangeType& ret, RangeType& tmp_ret)
   {
     Call<comb>::evaluate(left_local, right_local, xx, ret, tmp_ret);
   }
 
-  static void jacobian(const LeftLocalfunctionType& left_local, const RightLocalfunctionType& right_local,
-                       const DomainType& xx, JacobianRangeType& ret, JacobianRangeType& tmp_ret)
+  template <class LeftLocalType, class RightLocalType>
+  static void jacobian(const LeftLocalType& left_local, const RightLocalType& right_local, const DomainType& xx,
+                       JacobianRangeType& ret, JacobianRangeType& tmp_ret)
   {
     Call<comb>::jacobian(left_local, right_local, xx, ret, tmp_ret);
   }
 }; // class SelectCombined
 
+template <class LeftType, class RightType, Combination comb>
+class Combined;
+
+/**
+ * \brief Non-virtual local evaluation of a function of type FunctionType on an entity.
+ *
+ *        Used to fuse the local functions of (nested) combined functions into a single local function: the fused local
+ *        function of a combination holds those of its operands by value and does the arithmetic inline, so only leaves
+ *        which can not be fused need a local function of their own (and thus an allocation and virtual calls). This
+ *        default implementation is such a leaf, specializations exist for combined and global functions (and may be
+ *        added for other functions which can evaluate themselves cheaply on an entity, \sa Checkerboard).
+ *
+ *        Provides bind(), order(), evaluate() and jacobian() like LocalfunctionInterface, but non-virtual.
+ */
+template <class FunctionType, class Enable = void>
+class FusedLocalfunction
+{
+public:
+  typedef typename FunctionType::EntityType EntityType;
+  typedef typename FunctionType::LocalfunctionType LocalfunctionType;
+  typedef typename LocalfunctionType::DomainType DomainType;
+  typedef typename LocalfunctionType::RangeType RangeType;
+  typedef typename LocalfunctionType::JacobianRangeType JacobianRangeType;
+
+  FusedLocalfunction(const FunctionType& function, const EntityType& ent)
+    : function_(function)
+    , local_function_(function_.local_function(ent))
+  {
+  }
+
+  void bind(const EntityType& ent) { function_.bind_local_function(local_function_, ent); }
+
+  size_t order() const { return local_function_->order(); }
+
+  void evaluate(const DomainType& xx, RangeType& ret) const { local_function_->evaluate(xx, ret); }
+
+  void jacobian(const DomainType& xx, JacobianRangeType& ret) const { local_function_->jacobian(xx, ret); }
+
+private:
+  const FunctionType& function_;
+  std::unique_ptr<LocalfunctionType> local_function_;
+}; // class FusedLocalfunction
+
+//! Evaluates the global function directly, \sa FusedLocalfunction
+template <class FunctionType>
+class FusedLocalfunction<
+    FunctionType,
+    typename std::enable_if<std::is_base_of<
+        GlobalFunctionInterface<typename FunctionType::EntityType, typename FunctionType::DomainFieldType,
+                                FunctionType::dimDomain, typename FunctionType::RangeFieldType,
+                                FunctionType::dimRange, FunctionType::dimRangeCols>,
+        FunctionType>::value>::type>
+{
+public:
+  typedef typename FunctionType::EntityType EntityType;
+  typedef typename FunctionType::DomainType DomainType;
+  typedef typename FunctionType::RangeType RangeType;
+  typedef typename FunctionType::JacobianRangeType JacobianRangeType;
+
+  FusedLocalfunction(const FunctionType& function, const EntityType& ent)
+    : function_(function)
+    , geometry_(ent.geometry())
+  {
+  }
+
+  void bind(const EntityType& ent) { geometry_ = ent.geometry(); }
+
+  size_t order() const { return function_.order(); }
+
+  void evaluate(const DomainType& xx, RangeType& ret) const { function_.evaluate(geometry_.global(xx), ret); }
+
+  void jacobian(const DomainType& xx, JacobianRangeType& ret) const
+  {
+    function_.jacobian(geometry_.global(xx), ret);
+  }
+
+private:
+  const FunctionType& function_;
+  typename EntityType::Geometry geometry_;
+}; // class FusedLocalfunction< global function >
+
+/**
+ * \brief Fuses the local functions of both operands of a combined function, \sa FusedLocalfunction
+ * \note  Applies to Difference, Sum and Product as well.
+ */
+template <class FunctionType>
+class FusedLocalfunction<
+    FunctionType,
+    typename std::enable_if<std::is_base_of<Combined<typename FunctionType::LeftFunctionType,
+                                                     typename FunctionType::RightFunctionType,
+                                                     FunctionType::combination>,
+                                            FunctionType>::value>::type>
+{
+  typedef typename FunctionType::LeftFunctionType LeftType;
+  typedef typename FunctionType::RightFunctionType RightType;
+  typedef SelectCombined<LeftType, RightType, FunctionType::combination> Select;
+
+public:
+  typedef typename LeftType::EntityType EntityType;
+  typedef typename Select::DomainType DomainType;
+  typedef typename Select::RangeType RangeType;
+  typedef typename Select::JacobianRangeType JacobianRangeType;
+
+  FusedLocalfunction(const FunctionType& function, const EntityType& ent)
+    : FusedLocalfunction(function.left(), function.right(), ent)
+  {
+  }
+
+  FusedLocalfunction(const LeftType& left, const RightType& right, const EntityType& ent)
+    : left_local_(left, ent)
+    , right_local_(right, ent)
+    , tmp_range_(0.0)
+    , tmp_jacobian_(0.0)
+  {
+  }
+
+  void bind(const EntityType& ent)
+  {
+    left_local_.bind(ent);
+    right_local_.bind(ent);
+  }
+
+  size_t order() const { return Select::order(left_local_.order(), right_local_.order()); }
+
+  void evaluate(const DomainType& xx, RangeType& ret) const
+  {
+    Select::evaluate(left_local_, right_local_, xx, ret, tmp_range_);
+  }
+
+  void jacobian(const DomainType& xx, JacobianRangeType& ret) const
+  {
+    Select::jacobian(left_local_, right_local_, xx, ret, tmp_jacobian_);
+  }
+
+private:
+  FusedLocalfunction<LeftType> left_local_;
+  FusedLocalfunction<RightType> right_local_;
+  mutable RangeType tmp_range_;
+  mutable JacobianRangeType tmp_jacobian_;
+}; // class FusedLocalfunction< combined function >
+
 /**
  * \brief Generic combined local function.
  *
+ *        Holds the fused local functions of the whole (possibly nested) combination, \sa FusedLocalfunction. Thus,
+ *        combining concrete function types (e.g., by Difference< ConstantType, ExpressionType > or make_sum(...)
+ *        instead of the operators of LocalizableFunctionInterface, which only know about the interface) leads to a
+ *        single local function per entity with inlined arithmetic.
+ *
  * \note Most likely you do not want to use this class directly, but Combined.
  */
 template <class LeftType, class RightType, Combination type>
@@ -219,8 +374,6 @@ class CombinedLocalFunction
       SelectCombined<LeftType, RightType, type>::d, typename SelectCombined<LeftType, RightType, type>::R,
       SelectCombined<LeftType, RightType, type>::r, SelectCombined<LeftType, RightType, type>::rC> BaseType;
 
-  typedef SelectCombined<LeftType, RightType, type> Select;
-
 public:
   typedef typename BaseType::EntityType EntityType;
   typedef typename BaseType::DomainType DomainType;
@@ -229,30 +382,29 @@ public:
 
   CombinedLocalFunction(const LeftType& left, const RightType& right, const EntityType& ent)
     : BaseType(ent)
-    , left_local_(left.local_function(this->entity()))
-    , right_local_(right.local_function(this->entity()))
-    , tmp_range_(0.0)
-    , tmp_jacobian_(0.0)
+    , fused_(left, right, ent)
   {
   }
 
-  virtual size_t order() const override final { return Select::order(left_local_->order(), right_local_->order()); }
+  virtual bool is_bindable() const override final { return true; }
 
-  virtual void evaluate(const DomainType& xx, RangeType& ret) const override final
+  virtual void bind(const EntityType& ent) override final
   {
-    Select::evaluate(*left_local_, *right_local_, xx, ret, tmp_range_);
+    this->bind_entity(ent);
+    fused_.bind(ent);
   }
 
+  virtual size_t order() const override final { return fused_.order(); }
+
+  virtual void evaluate(const DomainType& xx, RangeType& ret) const override final { fused_.evaluate(xx, ret); }
+
   virtual void jacobian(const DomainType& xx, JacobianRangeType& ret) const override final
   {
-    Select::jacobian(*left_local_, *right_local_, xx, ret, tmp_jacobian_);
+    fused_.jacobian(xx, ret);
   }
 
 private:
-  const std::unique_ptr<const typename LeftType::LocalfunctionType> left_local_;
-  const std::unique_ptr<const typename RightType::LocalfunctionType> right_local_;
-  mutable RangeType tmp_range_;
-  mutable JacobianRangeType tmp_jacobian_;
+  FusedLocalfunction<Combined<LeftType, RightType, type>> fused_;
 }; // class CombinedLocalFunction
 
 /**
@@ -317,6 +469,9 @@ class Combined
 public:
   typedef typename BaseType::EntityType EntityType;
   typedef typename BaseType::LocalfunctionType LocalfunctionType;
+  typedef LeftType LeftFunctionType;
+  typedef RightType RightFunctionType;
+  static const Combination combination = comb;
 
   Combined(const LeftType& left, const RightType& right, const std::string nm = "")
     : left_(Common::make_unique<LeftStorageType>(left))
@@ -357,6 +512,10 @@ public:
 
   virtual ThisType* copy() const { DUNE_THROW(NotImplemented, "Are you kidding me?"); }
 
+  const LeftType& left() const { return left_->storage_access(); }
+
+  const RightType& right() const { return right_->storage_access(); }
+
   virtual std::string type() const override final
   {
     return SelectCombined<LeftType, RightType, comb>::type() + " of '" + left_->storage_access().type() + "' and '"
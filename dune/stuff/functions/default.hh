@@ -6,13 +6,27 @@
 #ifndef DUNE_STUFF_FUNCTIONS_VISUALIZATION_HH
 #define DUNE_STUFF_FUNCTIONS_VISUALIZATION_HH
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include <boost/numeric/conversion/cast.hpp>
 
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+#include <dune/geometry/virtualrefinement.hh>
+
 #if HAVE_DUNE_GRID
 #include <dune/grid/io/file/vtk/function.hh>
 #endif
 
+#include <dune/stuff/common/exceptions.hh>
 #include <dune/stuff/common/float_cmp.hh>
+#include <dune/stuff/common/memory.hh>
+#include <dune/stuff/common/parallel/threadstorage.hh>
+#if HAVE_DUNE_GRID
+#include <dune/stuff/grid/walker.hh>
+#endif
 
 #include "interfaces.hh"
 
@@ -22,6 +36,20 @@ namespace Functions {
 
 #if HAVE_DUNE_GRID
 
+/**
+ * \brief Provides a localizable function to the VTKWriter (or the SubsamplingVTKWriter).
+ *
+ *        If only given a function, each call to evaluate() creates a local function and evaluates it, which is
+ *        expensive for vector valued functions or fine grids. If additionally given a grid view, the values of all
+ *        components in all points the writer will request (the corners of each element, or the vertices of the virtual
+ *        refinement of each element if subsampling_level >= 0) are computed once beforehand, using one local function
+ *        per element (optionally in parallel). The writer is then served from these values; requests for other points
+ *        or entities fall back to evaluating the function.
+ *
+ *        evaluate() is thread safe in both cases.
+ * \note  Precomputing stores all values of the whole grid view at once, i.e. (number of elements) x (number of points
+ *        per element) x ncomps() doubles, which may be a lot for fine grids and subsampling.
+ */
 template <class GridViewType, size_t dimRange, size_t dimRangeCols>
 class VisualizationAdapter : public VTKFunction<GridViewType>
 {
@@ -35,11 +63,57 @@ public:
   typedef LocalizableFunctionInterface<EntityType, DomainFieldType, dimDomain, double, dimRange, dimRangeCols>
       FunctionType;
 
+private:
+  // the points the writer requests on all entities of one geometry type
+  struct LocalPoints
+  {
+    GeometryType type;
+    std::vector<DomainType> points;
+    size_t offset; // of the values of the first entity of this type
+  }; // struct LocalPoints
+
+public:
   VisualizationAdapter(const FunctionType& function, const std::string nm = "")
-    : function_(function), tmp_value_(0), name_(nm)
+    : function_(function)
+    , name_(nm)
+    , last_point_(0)
   {
   }
 
+  /**
+   * \brief Precomputes all values the writer will request on grid_view.
+   * \param subsampling_level has to match the level of the SubsamplingVTKWriter, use a negative level for the
+   *                          VTKWriter
+   */
+  VisualizationAdapter(const GridViewType& grid_view, const FunctionType& function, const int subsampling_level,
+                       const std::string nm = "", const bool use_tbb = false)
+    : function_(function)
+    , name_(nm)
+    , grid_view_(Common::make_unique<GridViewType>(grid_view))
+    , last_point_(0)
+  {
+    const auto& index_set = grid_view.indexSet();
+    size_t num_values = 0;
+    for (const auto& type : index_set.geomTypes(0)) {
+      local_points_.push_back({type, points(type, subsampling_level), num_values});
+      num_values += index_set.size(type) * local_points_.back().points.size() * ncomps();
+    }
+    values_.resize(num_values);
+    Grid::Walker<GridViewType> walker(grid_view);
+    walker.add([&](const EntityType& entity) {
+      const auto local_function = function_.local_function(entity);
+      const auto& local_points  = find(entity.type());
+      double* values = &values_[offset(local_points, index_set.index(entity))];
+      typename FunctionType::RangeType value(0);
+      for (const auto& point : local_points.points) {
+        local_function->evaluate(point, value);
+        for (int comp = 0; comp < ncomps(); ++comp)
+          *(values++) = Call<dimRange, dimRangeCols>::evaluate(comp, value);
+      }
+    });
+    walker.walk(use_tbb);
+  } // VisualizationAdapter(...)
+
 private:
   template <size_t r, size_t rC, bool anything = true>
   class Call
@@ -77,15 +151,63 @@ public:
   {
     assert(comp >= 0);
     assert(comp < boost::numeric_cast<int>(dimRange));
-    const auto local_func = function_.local_function(en);
-    local_func->evaluate(xx, tmp_value_);
-    return Call<dimRange, dimRangeCols>::evaluate(comp, tmp_value_);
-  }
+    // all geometry types of the grid view have been precomputed
+    if (grid_view_ && grid_view_->indexSet().contains(en)) {
+      const auto& local_points = find(en.type());
+      // the writer requests the points in order, so we first try the one after the last requested point
+      size_t& last_point = *last_point_;
+      const size_t num_points = local_points.points.size();
+      for (size_t ii = 0; ii < num_points; ++ii) {
+        const size_t point = (last_point + ii) % num_points;
+        if (Common::FloatCmp::eq(local_points.points[point], xx)) {
+          last_point = point;
+          return values_[offset(local_points, grid_view_->indexSet().index(en)) + point * ncomps() + comp];
+        }
+      }
+    }
+    // not precomputed, so we evaluate exactly as the precomputation did
+    typename FunctionType::RangeType value(0);
+    function_.local_function(en)->evaluate(xx, value);
+    return Call<dimRange, dimRangeCols>::evaluate(comp, value);
+  } // ... evaluate(...)
 
 private:
+  static std::vector<DomainType> points(const GeometryType& type, const int subsampling_level)
+  {
+    std::vector<DomainType> ret;
+    if (subsampling_level < 0) {
+      const auto& reference_element = ReferenceElements<DomainFieldType, dimDomain>::general(type);
+      for (int ii = 0; ii < reference_element.size(dimDomain); ++ii)
+        ret.push_back(reference_element.position(ii, dimDomain));
+    } else {
+      // as in the SubsamplingVTKWriter
+      const GeometryType subsampled_type = type.isCube() ? type : GeometryType(GeometryType::simplex, dimDomain);
+      auto& refinement = buildRefinement<dimDomain, DomainFieldType>(type, subsampled_type);
+      for (auto it = refinement.vBegin(subsampling_level); it != refinement.vEnd(subsampling_level); ++it)
+        ret.push_back(it.coords());
+    }
+    return ret;
+  } // ... points(...)
+
+  const LocalPoints& find(const GeometryType& type) const
+  {
+    for (const auto& local_points : local_points_)
+      if (local_points.type == type)
+        return local_points;
+    DUNE_THROW(Exceptions::internal_error, "No points were precomputed for geometry type " << type << "!");
+  }
+
+  size_t offset(const LocalPoints& local_points, const size_t index) const
+  {
+    return local_points.offset + index * local_points.points.size() * ncomps();
+  }
+
   const FunctionType& function_;
-  mutable typename FunctionType::RangeType tmp_value_;
   const std::string name_;
+  const std::unique_ptr<const GridViewType> grid_view_;
+  std::vector<LocalPoints> local_points_;
+  std::vector<double> values_;
+  mutable PerThreadValue<size_t> last_point_;
 }; // class VisualizationAdapter
 
 #endif // HAVE_DUNE_GRID
@@ -9,6 +9,7 @@
 #define DUNE_STUFF_FUNCTION_GLOBAL_HH
 
 #include <functional>
+#include <utility>
 
 #include <dune/stuff/functions/interfaces.hh>
 #include <dune/stuff/common/memory.hh>
@@ -56,6 +57,72 @@ private:
   const std::string name_;
 };
 
+/**
+ * \brief Like GlobalLambdaFunction, but stores the lambda by its own type instead of a std::function.
+ *
+ *        Templated code which knows the type of this function can call operator() or local_evaluate(), which are not
+ *        virtual and can be inlined completely, while dynamic users still get the full interface (the overrides of
+ *        which are final and thus also devirtualized if the type is known). Use make_inline_global_lambda_function()
+ *        to deduce the type of the lambda.
+ */
+template <class EntityImp, class DomainFieldImp, size_t domainDim, class RangeFieldImp, size_t rangeDim,
+          size_t rangeDimCols, class LambdaImp>
+class InlineGlobalLambdaFunction
+    : public GlobalFunctionInterface<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols>
+{
+  typedef GlobalFunctionInterface<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols> BaseType;
+
+public:
+  typedef typename BaseType::EntityType EntityType;
+  typedef typename BaseType::DomainType DomainType;
+  typedef typename BaseType::RangeType RangeType;
+  typedef LambdaImp LambdaType;
+
+  InlineGlobalLambdaFunction(LambdaType lambda, const size_t order_in,
+                             const std::string nm = "stuff.globallambdafunction")
+    : lambda_(std::move(lambda)), order_(order_in), name_(nm)
+  {
+  }
+
+  //! evaluates the lambda in the global point xx, without virtual calls
+  inline RangeType operator()(const DomainType& xx) const { return lambda_(xx); }
+
+  //! evaluates the lambda in the point xx, given in local coordinates of entity, without virtual calls
+  inline RangeType local_evaluate(const EntityType& entity, const DomainType& xx) const
+  {
+    return lambda_(entity.geometry().global(xx));
+  }
+
+  virtual size_t order() const override final { return order_; }
+
+  virtual void evaluate(const DomainType& xx, RangeType& ret) const override final { ret = lambda_(xx); }
+
+  virtual RangeType evaluate(const DomainType& xx) const override final { return lambda_(xx); }
+
+  virtual std::string type() const override { return "stuff.globallambdafunction"; }
+
+  virtual std::string name() const override { return name_; }
+
+private:
+  const LambdaType lambda_;
+  const size_t order_;
+  const std::string name_;
+}; // class InlineGlobalLambdaFunction
+
+/**
+ * \brief Creates an InlineGlobalLambdaFunction, the type of the lambda is deduced.
+ * \example auto func = make_inline_global_lambda_function<E, double, 2, double, 1>([](D x) { return R(x[0]); }, 1);
+ */
+template <class EntityImp, class DomainFieldImp, size_t domainDim, class RangeFieldImp, size_t rangeDim,
+          size_t rangeDimCols = 1, class LambdaImp>
+InlineGlobalLambdaFunction<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols, LambdaImp>
+make_inline_global_lambda_function(LambdaImp lambda, const size_t order_in,
+                                   const std::string nm = "stuff.globallambdafunction")
+{
+  return InlineGlobalLambdaFunction<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols,
+                                    LambdaImp>(std::move(lambda), order_in, nm);
+}
+
 } // namespace Stuff
 } // namespace Dune
 
@@ -45,7 +45,18 @@ class Indicator<E, D, d, R, 1> : public LocalizableFunctionInterface<E, D, d, R,
     using typename InterfaceType::RangeType;
     using typename InterfaceType::JacobianRangeType;
 
-    Localfunction(const EntityType& entity, const RangeType& value) : InterfaceType(entity), value_(value) {}
+    Localfunction(const EntityType& entity, const ThisType& function)
+      : InterfaceType(entity), function_(function), value_(function_.value(entity))
+    {
+    }
+
+    virtual bool is_bindable() const override final { return true; }
+
+    virtual void bind(const EntityType& entity) override final
+    {
+      this->bind_entity(entity);
+      value_ = function_.value(entity);
+    }
 
     virtual size_t order() const override final { return 0; }
 
@@ -62,7 +73,8 @@ class Indicator<E, D, d, R, 1> : public LocalizableFunctionInterface<E, D, d, R,
     }
 
   private:
-    const RangeType value_;
+    const ThisType& function_;
+    RangeType value_;
   }; // class Localfunction
 
 public:
@@ -141,13 +153,19 @@ public:
   virtual std::string name() const override final { return name_; }
 
   virtual std::unique_ptr<LocalfunctionType> local_function(const EntityType& entity) const override final
+  {
+    return Common::make_unique<Localfunction>(entity, *this);
+  }
+
+  //! value of the first domain containing the center of entity, 0 if there is none
+  RangeFieldType value(const EntityType& entity) const
   {
     const auto center = entity.geometry().center();
     for (const auto& element : values_)
       if (Common::FloatCmp::le(std::get<0>(element), center) && Common::FloatCmp::lt(center, std::get<1>(element)))
-        return Common::make_unique<Localfunction>(entity, std::get<2>(element));
-    return Common::make_unique<Localfunction>(entity, 0.0);
-  } // ... local_function(...)
+        return std::get<2>(element);
+    return 0.0;
+  } // ... value(...)
 
 private:
   static std::vector<std::tuple<DomainType, DomainType, R>>
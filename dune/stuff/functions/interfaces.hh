@@ -150,11 +150,11 @@ public:
   typedef typename RangeTypeSelector<RangeFieldType, dimRange, dimRangeCols>::type RangeType;
   typedef typename JacobianRangeTypeSelector<dimDomain, RangeFieldType, dimRange, dimRangeCols>::type JacobianRangeType;
 
-  LocalfunctionSetInterface(const EntityType& ent) : entity_(ent) {}
+  LocalfunctionSetInterface(const EntityType& ent) : entity_(&ent) {}
 
   virtual ~LocalfunctionSetInterface() {}
 
-  virtual const EntityType& entity() const { return entity_; }
+  virtual const EntityType& entity() const { return *entity_; }
 
   /**
    * \defgroup haveto ´´These methods have to be implemented.''
@@ -169,6 +169,25 @@ public:
   virtual void jacobian(const DomainType& /*xx*/, std::vector<JacobianRangeType>& /*ret*/) const = 0;
   /* @} */
 
+  /**
+   * \defgroup bindable ´´These methods should be implemented to allow for reuse of local functions.''
+   * @{
+   **/
+  //! \return true, if this local function supports bind()
+  virtual bool is_bindable() const { return false; }
+
+  /**
+   * \brief Rebinds this local function to another entity in place.
+   * \note  Implementations have to update all entity dependent state and should not allocate. The entity has to
+   *        outlive the binding, just as for the constructor.
+   * \sa    LocalizableFunctionInterface::bind_local_function
+   */
+  virtual void bind(const EntityType& /*ent*/)
+  {
+    DUNE_THROW(NotImplemented, "This local function cannot be rebound, create a new one instead!");
+  }
+  /* @} */
+
   /**
    * \defgroup provided ´´These methods are provided by the interface.''
    * @{
@@ -189,6 +208,9 @@ public:
   /* @} */
 
 protected:
+  //! to be called by implementations of bind()
+  void bind_entity(const EntityType& ent) { entity_ = &ent; }
+
   bool is_a_valid_point(const DomainType&
 #ifndef DUNE_STUFF_FUNCTIONS_DISABLE_CHECKS
                             xx
@@ -205,7 +227,7 @@ protected:
 #endif
   }
 
-  const EntityType& entity_;
+  const EntityType* entity_;
 }; // class LocalfunctionSetInterface
 
 /**
@@ -346,6 +368,28 @@ public:
   virtual std::unique_ptr<LocalfunctionType> local_function(const EntityType& /*entity*/) const = 0;
   /* @} */
 
+  /**
+   * \brief Provides a local function on entity in local_func, reusing the given one if possible.
+   *
+   *        If local_func is set and bindable, it is rebound to entity in place without any heap allocation, otherwise
+   *        a new one is obtained from local_function(). local_func has to stem from this function (or be empty).
+   *        Hold one local function per thread and call this for each entity:
+\code
+std::unique_ptr< LocalfunctionType > local_func;
+for (const auto& entity : DSC::entityRange(grid_view)) {
+  function.bind_local_function(local_func, entity);
+  local_func->evaluate(...);
+}
+\endcode
+   */
+  void bind_local_function(std::unique_ptr<LocalfunctionType>& local_func, const EntityType& entity) const
+  {
+    if (local_func && local_func->is_bindable())
+      local_func->bind(entity);
+    else
+      local_func = local_function(entity);
+  } // ... bind_local_function(...)
+
   /** \defgroup info ´´These methods should be implemented in order to identify the function.'' */
   /* @{ */
   virtual std::string type() const { return "stuff.function"; }
@@ -370,18 +414,25 @@ public:
   /**
    * \note  We use the SubsamplingVTKWriter (which is better for higher orders) by default. This means that the grid you
    *        see in the visualization is a refinement of the actual grid!
+   * \note  By default, the values are computed when the writer requests them. If precompute is true, all values are
+   *        computed before writing (in parallel if use_tbb is true), which is faster but stores all values of the whole
+   *        grid view at once, \sa Functions::VisualizationAdapter.
    */
   template <class GridViewType>
   void visualize(const GridViewType& grid_view, const std::string path, const bool subsampling = true,
-                 const VTK::OutputType vtk_output_type = VTK::appendedraw) const
+                 const VTK::OutputType vtk_output_type = VTK::appendedraw, const bool precompute = false,
+                 const bool use_tbb = false) const
   {
     if (path.empty())
       DUNE_THROW(RangeError, "Empty path given!");
     const auto directory = DSC::directoryOnly(path);
     const auto filename  = DSC::filenameOnly(path);
-    auto adapter = std::make_shared<Functions::VisualizationAdapter<GridViewType, dimRange, dimRangeCols>>(*this);
+    const int subsampling_level = subsampling ? 1 : -1;
+    typedef Functions::VisualizationAdapter<GridViewType, dimRange, dimRangeCols> AdapterType;
+    auto adapter = precompute ? std::make_shared<AdapterType>(grid_view, *this, subsampling_level, "", use_tbb)
+                              : std::make_shared<AdapterType>(*this);
     std::unique_ptr<VTKWriter<GridViewType>> vtk_writer =
-        subsampling ? DSC::make_unique<SubsamplingVTKWriter<GridViewType>>(grid_view, VTK::nonconforming)
+        subsampling ? DSC::make_unique<SubsamplingVTKWriter<GridViewType>>(grid_view, subsampling_level)
                     : DSC::make_unique<VTKWriter<GridViewType>>(grid_view, VTK::nonconforming);
     vtk_writer->addVertexData(adapter);
     DSC::testCreateDirectory(directory);
@@ -476,6 +527,14 @@ private:
 
     virtual ~Localfunction() {}
 
+    virtual bool is_bindable() const override final { return true; }
+
+    virtual void bind(const EntityImp& entity_in) override final
+    {
+      this->bind_entity(entity_in);
+      geometry_ = entity_in.geometry();
+    }
+
     virtual void evaluate(const DomainType& xx, RangeType& ret) const override final
     {
       const auto xx_global = geometry_.global(xx);
@@ -491,7 +550,7 @@ private:
     virtual size_t order() const override final { return global_function_.order(); }
 
   private:
-    const typename EntityImp::Geometry geometry_;
+    typename EntityImp::Geometry geometry_;
     const ThisType& global_function_;
   }; // class Localfunction
 
@@ -594,6 +653,14 @@ private:
     {
     }
 
+    virtual bool is_bindable() const override final { return true; }
+
+    virtual void bind(const EntityImp& entity_in) override final
+    {
+      this->bind_entity(entity_in);
+      geometry_ = entity_in.geometry();
+    }
+
     virtual void evaluate(const DomainType& xx, RangeType& ret) const override final
     {
       const auto xx_global = geometry_.global(xx);
@@ -609,7 +676,7 @@ private:
     virtual size_t order() const override final { return global_function_.order(); }
 
   private:
-    const typename EntityImp::Geometry geometry_;
+    typename EntityImp::Geometry geometry_;
     const ThisType& global_function_;
   }; // class Localfunction
 
@@ -0,0 +1,385 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_FUNCTIONS_NORMS_HH
+#define DUNE_STUFF_FUNCTIONS_NORMS_HH
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+
+#if HAVE_DUNE_GRID
+#include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+#endif
+
+#include <dune/stuff/common/parallel/threadstorage.hh>
+#include <dune/stuff/grid/walker.hh>
+
+#include "interfaces.hh"
+
+namespace Dune {
+namespace Stuff {
+namespace Functions {
+
+#if HAVE_DUNE_GRID
+
+/**
+ * \brief Computes norms of localizable functions (and of differences of two localizable functions) on a grid view.
+ *
+ *        All norms are computed by a single (optionally threaded, \sa Grid::Walker) walk over the grid view, using
+ *        quadratures of order 2 * (local order) + over_integrate. The local functions of each thread are bound to each
+ *        entity instead of being recreated (if supported, \sa LocalfunctionInterface::is_bindable), so that no
+ *        allocations take place during the walk.
+ *
+ *        The result is deterministic: each entity stores its contribution in a slot of its own, these are summed up
+ *        in the order of the element mapper afterwards, regardless of the number of threads. In parallel runs only
+ *        interior entities contribute, and the local results of all ranks are combined in the order of the ranks.
+ *
+ * \note  linf() returns the maximum over all quadrature points, which is exact for piecewise polynomials only if the
+ *        maximum is attained in a quadrature point.
+ */
+template <class GridViewImp>
+class NormIntegrator
+{
+  typedef NormIntegrator<GridViewImp> ThisType;
+
+public:
+  typedef GridViewImp GridViewType;
+  typedef typename GridViewType::template Codim<0>::Entity EntityType;
+  typedef typename GridViewType::ctype DomainFieldType;
+  static const size_t dimDomain = GridViewType::dimension;
+  typedef FieldVector<DomainFieldType, dimDomain> DomainType;
+
+private:
+  typedef MultipleCodimMultipleGeomTypeMapper<GridViewType, MCMGElementLayout> MapperType;
+
+  enum class Reduction
+  {
+    sum,
+    max
+  };
+
+  // the per-thread scratch, copies start empty (they are only created to initialize the storage of another thread)
+  template <class F, class G, class A>
+  struct LocalFunctions
+  {
+    LocalFunctions() {}
+
+    LocalFunctions(const LocalFunctions& /*other*/) {}
+
+    size_t order() const
+    {
+      size_t ret = f->order();
+      if (g)
+        ret = std::max(ret, g->order());
+      return ret;
+    }
+
+    std::unique_ptr<typename F::LocalfunctionType> f;
+    std::unique_ptr<typename G::LocalfunctionType> g;
+    std::unique_ptr<typename A::LocalfunctionType> a;
+    typename F::RangeType f_value;
+    typename G::RangeType g_value;
+    typename A::RangeType a_value;
+    typename F::JacobianRangeType f_jacobian;
+    typename G::JacobianRangeType g_jacobian;
+  }; // struct LocalFunctions
+
+public:
+  explicit NormIntegrator(const GridViewType& grid_view, const size_t over_integrate = 2, const bool use_tbb = false)
+    : grid_view_(grid_view)
+    , over_integrate_(over_integrate)
+    , use_tbb_(use_tbb)
+  {
+  }
+
+  //! \f$\|f\|_{L^2}\f$
+  template <class F>
+  double l2(const F& function) const
+  {
+    return compute_l2(function, static_cast<const F*>(nullptr));
+  }
+
+  //! \f$\|f - g\|_{L^2}\f$
+  template <class F, class G>
+  double l2(const F& function, const G& other) const
+  {
+    return compute_l2(function, &other);
+  }
+
+  //! \f$|f|_{H^1} = \|\nabla f\|_{L^2}\f$
+  template <class F>
+  double h1_semi(const F& function) const
+  {
+    return compute_h1_semi(function, static_cast<const F*>(nullptr));
+  }
+
+  //! \f$|f - g|_{H^1}\f$
+  template <class F, class G>
+  double h1_semi(const F& function, const G& other) const
+  {
+    return compute_h1_semi(function, &other);
+  }
+
+  //! \f$\|f\|_{H^1}\f$
+  template <class F>
+  double h1(const F& function) const
+  {
+    return std::sqrt(std::pow(l2(function), 2) + std::pow(h1_semi(function), 2));
+  }
+
+  //! \f$\|f - g\|_{H^1}\f$
+  template <class F, class G>
+  double h1(const F& function, const G& other) const
+  {
+    return std::sqrt(std::pow(l2(function, other), 2) + std::pow(h1_semi(function, other), 2));
+  }
+
+  //! \f$\|f\|_{L^\infty}\f$, \sa class documentation
+  template <class F>
+  double linf(const F& function) const
+  {
+    return compute_linf(function, static_cast<const F*>(nullptr));
+  }
+
+  //! \f$\|f - g\|_{L^\infty}\f$, \sa class documentation
+  template <class F, class G>
+  double linf(const F& function, const G& other) const
+  {
+    return compute_linf(function, &other);
+  }
+
+  /**
+   * \brief \f$\left(\int A \nabla f \cdot \nabla f\right)^{1/2}\f$ for scalar f
+   * \note  diffusion may be scalar or matrix valued (dimDomain x dimDomain).
+   */
+  template <class A, class F>
+  double energy(const A& diffusion, const F& function) const
+  {
+    return compute_energy(diffusion, function, static_cast<const F*>(nullptr));
+  }
+
+  //! \f$\left(\int A \nabla (f - g) \cdot \nabla (f - g)\right)^{1/2}\f$, \sa energy
+  template <class A, class F, class G>
+  double energy(const A& diffusion, const F& function, const G& other) const
+  {
+    return compute_energy(diffusion, function, &other);
+  }
+
+private:
+  template <class F, class G>
+  double compute_l2(const F& function, const G* other) const
+  {
+    typedef LocalFunctions<F, G, F> ScratchType;
+    return std::sqrt(walk(function,
+                          other,
+                          static_cast<const F*>(nullptr),
+                          [](ScratchType& scratch, const DomainType& xx) {
+                            scratch.f->evaluate(xx, scratch.f_value);
+                            if (scratch.g) {
+                              scratch.g->evaluate(xx, scratch.g_value);
+                              scratch.f_value -= scratch.g_value;
+                            }
+                            return norm2(scratch.f_value);
+                          },
+                          Reduction::sum));
+  } // ... compute_l2(...)
+
+  template <class F, class G>
+  double compute_h1_semi(const F& function, const G* other) const
+  {
+    typedef LocalFunctions<F, G, F> ScratchType;
+    return std::sqrt(walk(function,
+                          other,
+                          static_cast<const F*>(nullptr),
+                          [](ScratchType& scratch, const DomainType& xx) {
+                            scratch.f->jacobian(xx, scratch.f_jacobian);
+                            if (scratch.g) {
+                              scratch.g->jacobian(xx, scratch.g_jacobian);
+                              scratch.f_jacobian -= scratch.g_jacobian;
+                            }
+                            return norm2(scratch.f_jacobian);
+                          },
+                          Reduction::sum));
+  } // ... compute_h1_semi(...)
+
+  template <class F, class G>
+  double compute_linf(const F& function, const G* other) const
+  {
+    typedef LocalFunctions<F, G, F> ScratchType;
+    return walk(function,
+                other,
+                static_cast<const F*>(nullptr),
+                [](ScratchType& scratch, const DomainType& xx) {
+                  scratch.f->evaluate(xx, scratch.f_value);
+                  if (scratch.g) {
+                    scratch.g->evaluate(xx, scratch.g_value);
+                    scratch.f_value -= scratch.g_value;
+                  }
+                  return double(scratch.f_value.infinity_norm());
+                },
+                Reduction::max);
+  } // ... compute_linf(...)
+
+  template <class A, class F, class G>
+  double compute_energy(const A& diffusion, const F& function, const G* other) const
+  {
+    static_assert(F::dimRange == 1 && F::dimRangeCols == 1, "Only implemented for scalar functions!");
+    typedef LocalFunctions<F, G, A> ScratchType;
+    return std::sqrt(walk(function,
+                          other,
+                          &diffusion,
+                          [](ScratchType& scratch, const DomainType& xx) {
+                            scratch.f->jacobian(xx, scratch.f_jacobian);
+                            if (scratch.g) {
+                              scratch.g->jacobian(xx, scratch.g_jacobian);
+                              scratch.f_jacobian -= scratch.g_jacobian;
+                            }
+                            scratch.a->evaluate(xx, scratch.a_value);
+                            return energy_density(scratch.a_value, scratch.f_jacobian[0]);
+                          },
+                          Reduction::sum));
+  } // ... compute_energy(...)
+
+  template <class F, class G, class A, class IntegrandType>
+  double walk(const F& function, const G* other, const A* weight, const IntegrandType& integrand,
+              const Reduction reduction) const
+  {
+    static_assert(std::is_same<typename F::EntityType, EntityType>::value,
+                  "The functions have to be localizable w.r.t. the entities of GridViewType!");
+    static_assert(std::is_same<typename G::EntityType, EntityType>::value,
+                  "The functions have to be localizable w.r.t. the entities of GridViewType!");
+    static_assert(std::is_same<typename A::EntityType, EntityType>::value,
+                  "The functions have to be localizable w.r.t. the entities of GridViewType!");
+    const MapperType mapper(grid_view_);
+    std::vector<double> contributions(mapper.size(), 0.);
+    PerThreadValue<LocalFunctions<F, G, A>> scratch;
+    Grid::Walker<GridViewType> walker(grid_view_);
+    walker.add([&](const EntityType& entity) {
+      if (entity.partitionType() != InteriorEntity)
+        return;
+      auto& local_functions = *scratch;
+      function.bind_local_function(local_functions.f, entity);
+      if (other)
+        other->bind_local_function(local_functions.g, entity);
+      size_t order = local_functions.order();
+      if (weight) {
+        weight->bind_local_function(local_functions.a, entity);
+        order += local_functions.a->order();
+      }
+      const auto& quadrature =
+          QuadratureRules<DomainFieldType, dimDomain>::rule(entity.type(), int(2 * order + over_integrate_));
+      const auto geometry = entity.geometry();
+      double result = 0.;
+      for (const auto& point : quadrature) {
+        const double value = integrand(local_functions, point.position());
+        if (reduction == Reduction::sum)
+          result += point.weight() * geometry.integrationElement(point.position()) * value;
+        else
+          result = std::max(result, value);
+      }
+      contributions[mapper.map(entity)] = result;
+    });
+    walker.walk(use_tbb_);
+    return combine(grid_view_.comm(), combine(contributions, reduction), reduction);
+  } // ... walk(...)
+
+  // pairwise summation, which keeps the rounding error small and does not depend on the number of threads
+  static double combine(const std::vector<double>& values, const size_t begin, const size_t end)
+  {
+    if (end - begin <= 8) {
+      double ret = 0.;
+      for (size_t ii = begin; ii < end; ++ii)
+        ret += values[ii];
+      return ret;
+    }
+    const size_t middle = begin + (end - begin) / 2;
+    return combine(values, begin, middle) + combine(values, middle, end);
+  } // ... combine(...)
+
+  static double combine(const std::vector<double>& values, const Reduction reduction)
+  {
+    if (reduction == Reduction::sum)
+      return combine(values, 0, values.size());
+    return values.empty() ? 0. : *std::max_element(values.begin(), values.end());
+  }
+
+  // combines the local results of all ranks in the order of the ranks, to obtain the same value on each rank
+  template <class CommunicatorType>
+  static double combine(const CommunicatorType& communicator, const double local_result, const Reduction reduction)
+  {
+    if (communicator.size() == 1)
+      return local_result;
+    std::vector<double> results(communicator.size(), 0.);
+    // allgather() takes a non-const send buffer
+    double send = local_result;
+    communicator.allgather(&send, 1, results.data());
+    return combine(results, reduction);
+  }
+
+  template <class K, int SIZE>
+  static double norm2(const FieldVector<K, SIZE>& value)
+  {
+    return value.two_norm2();
+  }
+
+  template <class K, int ROWS, int COLS>
+  static double norm2(const FieldMatrix<K, ROWS, COLS>& value)
+  {
+    return value.frobenius_norm2();
+  }
+
+  // jacobians of matrix-valued functions
+  template <class K, int ROWS, int COLS, int SIZE>
+  static double norm2(const FieldVector<FieldMatrix<K, ROWS, COLS>, SIZE>& value)
+  {
+    double ret = 0.;
+    for (int ii = 0; ii < SIZE; ++ii)
+      ret += value[ii].frobenius_norm2();
+    return ret;
+  }
+
+  template <class K, class L>
+  static double energy_density(const FieldVector<K, 1>& diffusion, const FieldVector<L, dimDomain>& gradient)
+  {
+    return diffusion[0] * gradient.two_norm2();
+  }
+
+  template <class K, class L>
+  static double energy_density(const FieldMatrix<K, dimDomain, dimDomain>& diffusion,
+                               const FieldVector<L, dimDomain>& gradient)
+  {
+    FieldVector<L, dimDomain> tmp;
+    diffusion.mv(gradient, tmp);
+    return tmp * gradient;
+  }
+
+  const GridViewType grid_view_;
+  const size_t over_integrate_;
+  const bool use_tbb_;
+}; // class NormIntegrator
+
+template <class GridViewType>
+NormIntegrator<GridViewType> make_norm_integrator(const GridViewType& grid_view, const size_t over_integrate = 2,
+                                                  const bool use_tbb = false)
+{
+  return NormIntegrator<GridViewType>(grid_view, over_integrate, use_tbb);
+}
+
+#endif // HAVE_DUNE_GRID
+
+} // namespace Functions
+} // namespace Stuff
+} // namespace Dune
+
+#endif // DUNE_STUFF_FUNCTIONS_NORMS_HH
@@ -0,0 +1,249 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_FUNCTIONS_PIECEWISE_CONSTANT_CACHE_HH
+#define DUNE_STUFF_FUNCTIONS_PIECEWISE_CONSTANT_CACHE_HH
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <dune/geometry/referenceelements.hh>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/common/memory.hh>
+#include <dune/stuff/grid/walker.hh>
+
+#include "interfaces.hh"
+
+namespace Dune {
+namespace Stuff {
+namespace Functions {
+
+#if HAVE_DUNE_GRID
+
+/**
+ * \brief Caches the values of an elementwise constant function on all elements of a grid view.
+ *
+ *        The values of the wrapped function (like Checkerboard, Spe10::Model1, Indicator or ESV2007::Cutoff) are
+ *        computed once per element (in parallel, if requested) and stored contiguously, ordered by the index set of the
+ *        grid view. Afterwards, local_function() and bind() only check the size and the index set of the grid view and
+ *        do an indexed load instead of locating the cell of the entity.
+ *
+ *        The cache detects if the grid view has changed (entities which are not contained in the grid view or a
+ *        changed number of elements) and then falls back to the wrapped function for these entities until update() is
+ *        called. Only in debug builds (NDEBUG not defined), the id of each entity is additionally compared to the one
+ *        of the entity with the same index at the time of update(), which detects adaptations which kept the number of
+ *        elements, at the cost of an id lookup per local_function() and bind().
+ *
+ * \note  The wrapped function (and the grid view) have to outlive this cache if given by reference.
+ */
+template <class GridViewImp, class FunctionImp>
+class PiecewiseConstantCache
+    : public LocalizableFunctionInterface<typename FunctionImp::EntityType, typename FunctionImp::DomainFieldType,
+                                          FunctionImp::dimDomain, typename FunctionImp::RangeFieldType,
+                                          FunctionImp::dimRange, FunctionImp::dimRangeCols>
+{
+  typedef LocalizableFunctionInterface<typename FunctionImp::EntityType, typename FunctionImp::DomainFieldType,
+                                       FunctionImp::dimDomain, typename FunctionImp::RangeFieldType,
+                                       FunctionImp::dimRange, FunctionImp::dimRangeCols> BaseType;
+  typedef PiecewiseConstantCache<GridViewImp, FunctionImp> ThisType;
+
+public:
+  typedef GridViewImp GridViewType;
+  typedef FunctionImp FunctionType;
+  using typename BaseType::EntityType;
+  using typename BaseType::DomainFieldType;
+  using BaseType::dimDomain;
+  using typename BaseType::DomainType;
+  using typename BaseType::RangeFieldType;
+  using BaseType::dimRange;
+  using BaseType::dimRangeCols;
+  using typename BaseType::RangeType;
+  using typename BaseType::JacobianRangeType;
+  using typename BaseType::LocalfunctionType;
+
+  static_assert(std::is_same<EntityType, typename GridViewType::template Codim<0>::Entity>::value,
+                "FunctionType has to be localizable w.r.t. the entities of GridViewType!");
+
+private:
+  class Localfunction : public LocalfunctionType
+  {
+  public:
+    Localfunction(const ThisType& cache, const EntityType& ent)
+      : LocalfunctionType(ent)
+      , cache_(cache)
+      , value_(nullptr)
+    {
+      bind(ent);
+    }
+
+    Localfunction(const Localfunction& /*other*/) = delete;
+
+    Localfunction& operator=(const Localfunction& /*other*/) = delete;
+
+    virtual bool is_bindable() const override final { return true; }
+
+    //! points to the cached value of ent, or binds a local function of the wrapped function if ent is not cached
+    virtual void bind(const EntityType& ent) override final
+    {
+      this->bind_entity(ent);
+      if (cache_.cached(ent))
+        value_ = &cache_.value(ent);
+      else {
+        value_ = nullptr;
+        cache_.function_.access().bind_local_function(fallback_, ent);
+      }
+    } // ... bind(...)
+
+    virtual size_t order() const override final { return value_ ? 0 : fallback_->order(); }
+
+    virtual void evaluate(const DomainType& xx, RangeType& ret) const override final
+    {
+      assert(this->is_a_valid_point(xx));
+      if (value_)
+        ret = *value_;
+      else
+        fallback_->evaluate(xx, ret);
+    }
+
+    virtual void jacobian(const DomainType& xx, JacobianRangeType& ret) const override final
+    {
+      assert(this->is_a_valid_point(xx));
+      if (value_)
+        jacobian_helper(ret, internal::ChooseVariant<dimRangeCols>());
+      else
+        fallback_->jacobian(xx, ret);
+    }
+
+  private:
+    template <size_t rC>
+    void jacobian_helper(JacobianRangeType& ret, internal::ChooseVariant<rC>) const
+    {
+      for (auto& col_jacobian : ret)
+        col_jacobian *= RangeFieldType(0);
+    }
+
+    void jacobian_helper(JacobianRangeType& ret, internal::ChooseVariant<1>) const { ret *= RangeFieldType(0); }
+
+    const ThisType& cache_;
+    const RangeType* value_;
+    std::unique_ptr<LocalfunctionType> fallback_;
+  }; // class Localfunction
+
+  typedef typename GridViewType::Grid::LocalIdSet::IdType IdType;
+
+public:
+  static std::string static_id() { return BaseType::static_id() + ".piecewiseconstantcache"; }
+
+  PiecewiseConstantCache(const GridViewType& grid_view, const FunctionType& function, const bool use_tbb = false)
+    : grid_view_(grid_view), function_(function)
+  {
+    update(use_tbb);
+  }
+
+  PiecewiseConstantCache(const GridViewType& grid_view, std::shared_ptr<const FunctionType> function,
+                         const bool use_tbb = false)
+    : grid_view_(grid_view), function_(function)
+  {
+    update(use_tbb);
+  }
+
+  PiecewiseConstantCache(const ThisType& other) = delete;
+
+  ThisType& operator=(const ThisType& other) = delete;
+
+  virtual std::string type() const override final { return static_id(); }
+
+  virtual std::string name() const override final { return function_.access().name(); }
+
+  /**
+   * \brief (Re)computes all values, has to be called after the grid view has changed.
+   * \note  Not thread safe, do not call this while other threads are using this function.
+   */
+  void update(const bool use_tbb = false)
+  {
+    const auto& index_set = grid_view_.indexSet();
+    values_.resize(index_set.size(0));
+#ifndef NDEBUG
+    const auto& id_set = grid_view_.grid().localIdSet();
+    ids_.resize(index_set.size(0));
+#endif // NDEBUG
+    const auto& function = function_.access();
+    Grid::Walker<GridViewType> walker(grid_view_);
+    walker.add([&](const EntityType& entity) {
+      const auto local_function = function.local_function(entity);
+      if (local_function->order() != 0)
+        DUNE_THROW(Exceptions::requirements_not_met,
+                   "Only elementwise constant functions can be cached (order is " << local_function->order() << ")!");
+      const auto& reference_element = ReferenceElements<DomainFieldType, dimDomain>::general(entity.type());
+      const auto index = index_set.index(entity);
+      local_function->evaluate(reference_element.position(0, 0), values_[index]);
+#ifndef NDEBUG
+      ids_[index] = id_set.id(entity);
+#endif // NDEBUG
+    });
+    walker.walk(use_tbb);
+  } // ... update(...)
+
+  /**
+   * \return false, if update() has to be called before the cached values are used again
+   * \note   Changes which keep the number of elements are only detected per entity and only in debug builds, \sa
+   *         local_function()
+   */
+  bool valid() const { return grid_view_.indexSet().size(0) == values_.size(); }
+
+  //! \return the cached value of entity (which has to be contained in the grid view)
+  const RangeType& value(const EntityType& entity) const
+  {
+    assert(grid_view_.indexSet().contains(entity));
+    return values_[grid_view_.indexSet().index(entity)];
+  }
+
+  //! the cached values, ordered by the index set of the grid view
+  const std::vector<RangeType>& values() const { return values_; }
+
+  virtual std::unique_ptr<LocalfunctionType> local_function(const EntityType& entity) const override final
+  {
+    if (!cached(entity))
+      return function_.access().local_function(entity);
+    return Common::make_unique<Localfunction>(*this, entity);
+  }
+
+private:
+  bool cached(const EntityType& entity) const
+  {
+#ifndef NDEBUG
+    return valid() && grid_view_.indexSet().contains(entity)
+           && ids_[grid_view_.indexSet().index(entity)] == grid_view_.grid().localIdSet().id(entity);
+#else // NDEBUG
+    return valid() && grid_view_.indexSet().contains(entity);
+#endif // NDEBUG
+  }
+
+  const GridViewType grid_view_;
+  const Common::ConstStorageProvider<FunctionType> function_;
+  std::vector<RangeType> values_;
+#ifndef NDEBUG
+  std::vector<IdType> ids_;
+#endif // NDEBUG
+}; // class PiecewiseConstantCache
+
+template <class GridViewType, class FunctionType>
+std::unique_ptr<PiecewiseConstantCache<GridViewType, FunctionType>>
+    make_piecewise_constant_cache(const GridViewType& grid_view,
+                                  const FunctionType& function,
+                                  const bool use_tbb = false)
+{
+  return Common::make_unique<PiecewiseConstantCache<GridViewType, FunctionType>>(grid_view, function, use_tbb);
+}
+
+#endif // HAVE_DUNE_GRID
+
+} // namespace Functions
+} // namespace Stuff
+} // namespace Dune
+
+#endif // DUNE_STUFF_FUNCTIONS_PIECEWISE_CONSTANT_CACHE_HH
@@ -0,0 +1,339 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_FUNCTIONS_QUADRATURE_CACHE_HH
+#define DUNE_STUFF_FUNCTIONS_QUADRATURE_CACHE_HH
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dune/common/unused.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/stuff/common/memory.hh>
+#include <dune/stuff/common/parallel/threadstorage.hh>
+
+#include "interfaces.hh"
+
+namespace Dune {
+namespace Stuff {
+namespace Functions {
+
+#if HAVE_DUNE_GRID
+
+/**
+ * \brief Caches the values and jacobians of a function in the quadrature points of all elements of a grid view.
+ *
+ *        Meant for repeated assemblies with the same (stationary) coefficients, e.g. in time stepping or nonlinear
+ *        iterations: values(entity, quadrature) evaluates the wrapped function in all points of quadrature on first
+ *        request and stores the result in a flat arena (one per quadrature rule, indexed by the index of the entity in
+ *        the index set of the grid view). Subsequent requests only return a pointer into this arena. The same holds for
+ *        jacobians(entity, quadrature).
+ *
+ *        The arenas are allocated as a whole on first use of a quadrature rule, as long as the total memory stays
+ *        within max_bytes. Requests which can not be cached (rules beyond the budget, entities not contained in the
+ *        grid view or a changed grid view) are evaluated into a per-thread buffer instead. Call invalidate() once the
+ *        function or the grid view has changed, or invalidate(entity) to recompute the values of a single entity.
+ *
+ *        Requesting values is thread safe, each entity is evaluated only once even if requested concurrently.
+ *
+ * \note  The wrapped function (and the grid view) have to outlive this cache if given by reference.
+ */
+template <class GridViewImp, class FunctionImp>
+class QuadratureCache
+{
+  typedef QuadratureCache<GridViewImp, FunctionImp> ThisType;
+
+public:
+  typedef GridViewImp GridViewType;
+  typedef FunctionImp FunctionType;
+  typedef typename FunctionType::EntityType EntityType;
+  typedef typename FunctionType::DomainFieldType DomainFieldType;
+  static const size_t dimDomain = FunctionType::dimDomain;
+  typedef typename FunctionType::DomainType DomainType;
+  typedef typename FunctionType::RangeType RangeType;
+  typedef typename FunctionType::JacobianRangeType JacobianRangeType;
+  typedef Dune::QuadratureRule<DomainFieldType, dimDomain> QuadratureType;
+
+  static_assert(std::is_same<EntityType, typename GridViewType::template Codim<0>::Entity>::value,
+                "FunctionType has to be localizable w.r.t. the entities of GridViewType!");
+
+private:
+  // enough for all orders on all geometry types used in practice
+  static const size_t max_num_rules = 64;
+
+  enum State : char
+  {
+    empty,
+    busy,
+    ready
+  };
+
+  template <class T>
+  struct Arena
+  {
+    enum Status : char
+    {
+      unallocated,
+      allocated,
+      over_budget
+    };
+
+    Arena()
+      : status(unallocated)
+    {
+    }
+
+    void allocate(const size_t num_entities, const size_t num_points)
+    {
+      data.resize(num_entities * num_points);
+      state = std::unique_ptr<std::atomic<char>[]>(new std::atomic<char>[num_entities]);
+      for (size_t ii = 0; ii < num_entities; ++ii)
+        state[ii] = empty;
+      status.store(allocated, std::memory_order_release);
+    }
+
+    std::vector<T> data;
+    std::unique_ptr<std::atomic<char>[]> state;
+    std::atomic<char> status;
+  }; // struct Arena
+
+  // all cached values of one quadrature rule
+  struct Table
+  {
+    explicit Table(const QuadratureType& quadrature)
+      : type(quadrature.type())
+      , order(quadrature.order())
+    {
+      for (const auto& point : quadrature)
+        points.push_back(point.position());
+    }
+
+    bool matches(const QuadratureType& quadrature) const
+    {
+      if (quadrature.type() != type || quadrature.order() != order || quadrature.size() != points.size())
+        return false;
+      for (size_t ii = 0; ii < points.size(); ++ii)
+        if (quadrature[ii].position() != points[ii])
+          return false;
+      return true;
+    }
+
+    const GeometryType type;
+    const int order;
+    std::vector<DomainType> points;
+    size_t num_entities;
+    Arena<RangeType> values;
+    Arena<JacobianRangeType> jacobians;
+  }; // struct Table
+
+public:
+  QuadratureCache(const GridViewType& grid_view, const FunctionType& function,
+                  const size_t max_bytes = std::numeric_limits<size_t>::max())
+    : grid_view_(grid_view)
+    , function_(function)
+    , max_bytes_(max_bytes)
+    , num_tables_(0)
+    , memory_usage_(0)
+  {
+  }
+
+  QuadratureCache(const GridViewType& grid_view, std::shared_ptr<const FunctionType> function,
+                  const size_t max_bytes = std::numeric_limits<size_t>::max())
+    : grid_view_(grid_view)
+    , function_(function)
+    , max_bytes_(max_bytes)
+    , num_tables_(0)
+    , memory_usage_(0)
+  {
+  }
+
+  QuadratureCache(const ThisType& other) = delete;
+
+  ThisType& operator=(const ThisType& other) = delete;
+
+  const FunctionType& function() const { return function_.access(); }
+
+  /**
+   * \brief The values of the function in all points of quadrature (mapped to entity).
+   * \return A pointer to quadrature.size() values, which stays valid until the next call to invalidate() if the
+   *         values are cached, and until the next request of this thread otherwise.
+   */
+  const RangeType* values(const EntityType& entity, const QuadratureType& quadrature) const
+  {
+    return get(entity,
+               quadrature,
+               &Table::values,
+               *values_buffer_,
+               [](const typename FunctionType::LocalfunctionType& lf, const DomainType& xx, RangeType& ret) {
+                 lf.evaluate(xx, ret);
+               });
+  }
+
+  //! The jacobians of the function in all points of quadrature, \sa values
+  const JacobianRangeType* jacobians(const EntityType& entity, const QuadratureType& quadrature) const
+  {
+    return get(entity,
+               quadrature,
+               &Table::jacobians,
+               *jacobians_buffer_,
+               [](const typename FunctionType::LocalfunctionType& lf, const DomainType& xx, JacobianRangeType& ret) {
+                 lf.jacobian(xx, ret);
+               });
+  }
+
+  /**
+   * \brief Drops all cached values and releases their memory, has to be called after the function or the grid view
+   *        have changed.
+   * \note  Not thread safe, do not call this while other threads are using this cache.
+   */
+  void invalidate()
+  {
+    for (size_t ii = 0; ii < num_tables_; ++ii)
+      tables_[ii].reset();
+    num_tables_   = 0;
+    memory_usage_ = 0;
+  }
+
+  //! Drops the cached values of entity, which are recomputed on the next request.
+  void invalidate(const EntityType& entity)
+  {
+    if (!grid_view_.indexSet().contains(entity))
+      return;
+    const size_t index = grid_view_.indexSet().index(entity);
+    for (size_t ii = 0; ii < num_tables_; ++ii) {
+      auto& table = *tables_[ii];
+      if (table.type == entity.type() && index < table.num_entities) {
+        if (table.values.status == Arena<RangeType>::allocated)
+          table.values.state[index] = empty;
+        if (table.jacobians.status == Arena<JacobianRangeType>::allocated)
+          table.jacobians.state[index] = empty;
+      }
+    }
+  } // ... invalidate(...)
+
+  //! the number of bytes currently allocated for cached values
+  size_t memory_usage() const { return memory_usage_; }
+
+private:
+  template <class T, class EvaluationType>
+  const T* get(const EntityType& entity, const QuadratureType& quadrature, Arena<T> Table::*arena_ptr,
+               std::vector<T>& buffer, const EvaluationType& evaluate) const
+  {
+    const auto& index_set = grid_view_.indexSet();
+    Table* table          = index_set.contains(entity) ? find_or_create(quadrature) : nullptr;
+    const size_t index    = table ? index_set.index(entity) : 0;
+    if (table && index < table->num_entities && index_set.size(table->type) == table->num_entities) {
+      auto& arena = (*table).*arena_ptr;
+      if (arena.status.load(std::memory_order_acquire) == Arena<T>::unallocated)
+        allocate(arena, table->num_entities, quadrature.size());
+      if (arena.status.load(std::memory_order_acquire) == Arena<T>::allocated) {
+        T* ret      = arena.data.data() + index * quadrature.size();
+        auto& state = arena.state[index];
+        while (true) {
+          char current = state.load(std::memory_order_acquire);
+          if (current == ready)
+            return ret;
+          if (current == empty) {
+            if (state.compare_exchange_strong(current, busy, std::memory_order_acq_rel)) {
+              try {
+                evaluate_all(entity, quadrature, ret, evaluate);
+              } catch (...) {
+                state.store(empty, std::memory_order_release);
+                throw;
+              }
+              state.store(ready, std::memory_order_release);
+              return ret;
+            }
+          } else {
+            // another thread is computing these values, if it fails we compute them ourselves
+            std::this_thread::yield();
+          }
+        }
+      }
+    }
+    if (buffer.size() < quadrature.size())
+      buffer.resize(quadrature.size());
+    evaluate_all(entity, quadrature, buffer.data(), evaluate);
+    return buffer.data();
+  } // ... get(...)
+
+  template <class T, class EvaluationType>
+  void evaluate_all(const EntityType& entity, const QuadratureType& quadrature, T* ret,
+                    const EvaluationType& evaluate) const
+  {
+    const auto local_function = function_.access().local_function(entity);
+    for (size_t ii = 0; ii < quadrature.size(); ++ii)
+      evaluate(*local_function, quadrature[ii].position(), ret[ii]);
+  }
+
+  Table* find_or_create(const QuadratureType& quadrature) const
+  {
+    size_t num_tables = num_tables_.load(std::memory_order_acquire);
+    for (size_t ii = 0; ii < num_tables; ++ii)
+      if (tables_[ii]->matches(quadrature))
+        return tables_[ii].get();
+    std::lock_guard<std::mutex> DUNE_UNUSED(guard)(mutex_);
+    // another thread might have created the table in the meantime
+    for (size_t ii = num_tables; ii < num_tables_; ++ii)
+      if (tables_[ii]->matches(quadrature))
+        return tables_[ii].get();
+    num_tables = num_tables_;
+    if (num_tables == max_num_rules)
+      return nullptr;
+    tables_[num_tables]               = Common::make_unique<Table>(quadrature);
+    tables_[num_tables]->num_entities = grid_view_.indexSet().size(quadrature.type());
+    num_tables_.store(num_tables + 1, std::memory_order_release);
+    return tables_[num_tables].get();
+  } // ... find_or_create(...)
+
+  template <class T>
+  void allocate(Arena<T>& arena, const size_t num_entities, const size_t num_points) const
+  {
+    std::lock_guard<std::mutex> DUNE_UNUSED(guard)(mutex_);
+    if (arena.status != Arena<T>::unallocated)
+      return;
+    const size_t bytes = num_entities * (num_points * sizeof(T) + sizeof(std::atomic<char>));
+    if (bytes > max_bytes_ - std::min(max_bytes_, size_t(memory_usage_))) {
+      arena.status = Arena<T>::over_budget;
+      return;
+    }
+    arena.allocate(num_entities, num_points);
+    memory_usage_ += bytes;
+  } // ... allocate(...)
+
+  const GridViewType grid_view_;
+  const Common::ConstStorageProvider<FunctionType> function_;
+  const size_t max_bytes_;
+  mutable std::array<std::unique_ptr<Table>, max_num_rules> tables_;
+  mutable std::atomic<size_t> num_tables_;
+  mutable std::atomic<size_t> memory_usage_;
+  mutable std::mutex mutex_;
+  mutable PerThreadValue<std::vector<RangeType>> values_buffer_;
+  mutable PerThreadValue<std::vector<JacobianRangeType>> jacobians_buffer_;
+}; // class QuadratureCache
+
+template <class GridViewType, class FunctionType>
+std::unique_ptr<QuadratureCache<GridViewType, FunctionType>>
+make_quadrature_cache(const GridViewType& grid_view, const FunctionType& function,
+                      const size_t max_bytes = std::numeric_limits<size_t>::max())
+{
+  return Common::make_unique<QuadratureCache<GridViewType, FunctionType>>(grid_view, function, max_bytes);
+}
+
+#endif // HAVE_DUNE_GRID
+
+} // namespace Functions
+} // namespace Stuff
+} // namespace Dune
+
+#endif // DUNE_STUFF_FUNCTIONS_QUADRATURE_CACHE_HH
@@ -6,15 +6,27 @@
 #ifndef DUNE_STUFF_FUNCTION_RandomEllipsoidsFunction_HH
 #define DUNE_STUFF_FUNCTION_RandomEllipsoidsFunction_HH
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include <cmath>
 #include <memory>
+#include <random>
+#include <string>
+
+#if HAVE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
 
 #include <dune/common/exceptions.hh>
 
+#include <dune/stuff/common/bounding-box-tree.hh>
 #include <dune/stuff/common/configuration.hh>
 #include <dune/stuff/common/debug.hh>
 #include <dune/stuff/common/fvector.hh>
+#include <dune/stuff/common/mapped-array.hh>
 #include <dune/stuff/common/random.hh>
 #include <dune/stuff/grid/information.hh>
 
@@ -28,6 +40,7 @@ template <size_t dim, class CoordType = double>
 struct Ellipsoid
 {
   typedef DSC::FieldVector<CoordType, dim> DomainType;
+  typedef DSC::BoundingBox<CoordType, dim> BoundingBoxType;
   DomainType center;
   DomainType radii;
 
@@ -41,7 +54,25 @@ struct Ellipsoid
     }
     return DSC::FloatCmp::le(sum, 1.);
   }
-  bool intersects_cube(DomainType /*ll*/, DomainType /*ur*/) const { DUNE_THROW(NotImplemented, ""); }
+
+  //! exact, since the ellipsoid is axis aligned: checks if the point of the cube closest to the center is contained
+  bool intersects_cube(DomainType ll, DomainType ur) const
+  {
+    double sum = 0;
+    for (auto ii : DSC::valueRange(dim)) {
+      const auto closest = std::min(std::max(center[ii], ll[ii]), ur[ii]);
+      sum += std::pow(closest - center[ii], 2) / std::pow(radii[ii], 2);
+    }
+    return DSC::FloatCmp::le(sum, 1.);
+  }
+
+  BoundingBoxType bounding_box() const
+  {
+    BoundingBoxType ret(center, center);
+    ret.lower_left -= radii;
+    ret.upper_right += radii;
+    return ret;
+  }
 };
 
 template <class EntityImp, class DomainFieldImp, size_t domainDim, class RangeFieldImp, size_t rangeDim,
@@ -65,6 +96,16 @@ public:
   typedef typename BaseType::RangeFieldType RangeFieldType;
   typedef typename BaseType::RangeType RangeType;
   typedef Ellipsoid<dimDomain, DomainFieldType> EllipsoidType;
+
+private:
+  typedef Common::BoundingBoxTree<DomainFieldType, dimDomain> BoundingBoxTreeType;
+  typedef typename BoundingBoxTreeType::BoxType BoundingBoxType;
+
+public:
+  /**
+   * \brief Only knows about the ellipsoids intersecting its entity.
+   * \note  Points to the ellipsoids of the function, which thus has to outlive its local functions.
+   */
   class Localfunction
       : public LocalfunctionInterface<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols>
   {
@@ -79,8 +120,8 @@ public:
     typedef typename BaseType::RangeType RangeType;
     typedef typename BaseType::JacobianRangeType JacobianRangeType;
 
-    Localfunction(const EntityType& ent, const RangeType value, std::vector<EllipsoidType>&& local_ellipsoids)
-      : BaseType(ent), geometry_(ent.geometry()), value_(value), local_ellipsoids_(local_ellipsoids)
+    Localfunction(const EntityType& ent, const RangeType value, std::vector<const EllipsoidType*>&& local_ellipsoids)
+      : BaseType(ent), geometry_(ent.geometry()), value_(value), local_ellipsoids_(std::move(local_ellipsoids))
     {
       //      DSC_LOG_DEBUG_0 << "create local LF Ellips with " << local_ellipsoids_.size() << " instances\n";
     }
@@ -96,9 +137,9 @@ public:
       assert(this->is_a_valid_point(xx_local));
       const auto xx_global = geometry_.global(xx_local);
       for (const auto& ellipsoid : local_ellipsoids_) {
-        if (ellipsoid.contains(xx_global)) {
+        if (ellipsoid->contains(xx_global)) {
           ret = value_;
-          //          DSC_LOG_DEBUG_0 << "ell  INSIDE " << ellipsoid.center << " with xx " << xx_global << "\n";
+          //          DSC_LOG_DEBUG_0 << "ell  INSIDE " << ellipsoid->center << " with xx " << xx_global << "\n";
           return;
         }
       }
@@ -114,7 +155,7 @@ public:
   private:
     const typename EntityImp::Geometry geometry_;
     const RangeType value_;
-    const std::vector<EllipsoidType> local_ellipsoids_;
+    const std::vector<const EllipsoidType*> local_ellipsoids_;
   }; // class Localfunction
 
 public:
@@ -151,55 +192,132 @@ public:
                            const Stuff::Common::Configuration& ellipsoid_cfg, const std::string nm = static_id())
     : lowerLeft_(lowerLeft), upperRight_(upperRight), name_(nm), ellipsoid_cfg_(ellipsoid_cfg)
   {
-    typedef unsigned long UL;
-    const UL level_0_count = ellipsoid_cfg.get("ellipsoids.count", 10);
-    const UL max_depth     = ellipsoid_cfg.get("ellipsoids.recursion_depth", 1);
-    const UL children      = ellipsoid_cfg.get<UL>("ellipsoids.children", 3u); //, DSC::ValidateLess<UL>(0));
-    const UL total_count = level_0_count + level_0_count * std::pow(children, max_depth + 1);
-    ellipsoids_.resize(level_0_count);
-    ellipsoids_.reserve(total_count);
-    const auto seed               = DomainFieldType(ellipsoid_cfg.get("ellipsoids.seed", 0));
+    const size_t num_families = ellipsoid_cfg.get<size_t>("ellipsoids.count", 10u);
+    const size_t size         = family_size(ellipsoid_cfg);
+    ellipsoids_.resize(num_families * size);
+#if HAVE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_families), [&](const tbb::blocked_range<size_t>& range) {
+      for (size_t ii = range.begin(); ii != range.end(); ++ii)
+        generate_family(ellipsoid_cfg, ii, ellipsoids_.data() + ii * size);
+    });
+#else
+    for (size_t ii = 0; ii < num_families; ++ii)
+      generate_family(ellipsoid_cfg, ii, ellipsoids_.data() + ii * size);
+#endif
+    DSC_LOG_DEBUG_0 << "generated " << ellipsoids_.size() << " ellipsoids\n";
+    build_tree();
+    to_file(*DSC::make_ofstream("ellipsoids.txt"));
+  }
+
+  //! the number of ellipsoids in each family (a level 0 ellipsoid and all its descendants)
+  static size_t family_size(const Stuff::Common::Configuration& ellipsoid_cfg)
+  {
+    const size_t max_depth = ellipsoid_cfg.get<size_t>("ellipsoids.recursion_depth", 1u);
+    const size_t children  = ellipsoid_cfg.get<size_t>("ellipsoids.children", 3u);
+    size_t ret             = 1;
+    size_t level_size      = 1;
+    for (size_t level = 0; level <= max_depth; ++level) {
+      level_size *= children;
+      ret += level_size;
+    }
+    return ret;
+  } // ... family_size(...)
+
+  /**
+   * \brief Generates the ii-th level 0 ellipsoid followed by all its descendants (depth first) into
+   *        ret[0, family_size(ellipsoid_cfg)).
+   *
+   *        All random numbers of a family are drawn from stream ii of a counter-based generator seeded with
+   *        "ellipsoids.seed", \sa Common::Philox4x32. Families may thus be generated in any order, in parallel or on
+   *        different ranks, the result is always the same.
+   */
+  static void generate_family(const Stuff::Common::Configuration& ellipsoid_cfg, const size_t ii, EllipsoidType* ret)
+  {
+    const size_t max_depth        = ellipsoid_cfg.get<size_t>("ellipsoids.recursion_depth", 1u);
+    const size_t children         = ellipsoid_cfg.get<size_t>("ellipsoids.children", 3u);
     const auto min_radius         = ellipsoid_cfg.get("ellipsoids.min_radius", 0.01);
     const auto max_radius         = ellipsoid_cfg.get("ellipsoids.max_radius", 0.02);
     const auto child_displacement = ellipsoid_cfg.get("ellipsoids.max_child_displacement", max_radius);
-    typedef DSC::DefaultRNG<DomainFieldType> RNG;
-    RNG center_rng(0, 1, seed);
-    RNG radii_rng(min_radius, max_radius, seed);
-    RNG dist_rng(min_radius, child_displacement, seed);
-    RNG sign_rng(-1, 1, seed);
-
-    const auto parent_range = DSC::valueRange(0ul, level_0_count);
-    for (auto ii : parent_range) {
-      std::generate(
-          ellipsoids_[ii].center.begin(), ellipsoids_[ii].center.end(), [&center_rng]() { return center_rng(); });
-      std::generate(ellipsoids_[ii].radii.begin(), ellipsoids_[ii].radii.end(), [&radii_rng]() { return radii_rng(); });
-    }
-
-    std::function<void(UL, const EllipsoidType&)> recurse_add = [&](UL current_level, const EllipsoidType& parent) {
-      if (current_level > max_depth)
+    const auto recursion_scale    = ellipsoid_cfg.get("ellipsoids.recursion_scale", 0.5);
+    Common::Philox4x32 engine(ellipsoid_cfg.get<std::uint64_t>("ellipsoids.seed", 0u), ii);
+    std::uniform_real_distribution<DomainFieldType> center_distribution(0, 1);
+    std::uniform_real_distribution<DomainFieldType> radius_distribution(min_radius, max_radius);
+    std::uniform_real_distribution<DomainFieldType> displacement_distribution(min_radius, child_displacement);
+    std::bernoulli_distribution sign_distribution;
+
+    EllipsoidType* next = ret;
+    for (auto& coord : next->center)
+      coord = center_distribution(engine);
+    for (auto& radius : next->radii)
+      radius = radius_distribution(engine);
+    ++next;
+    std::function<void(size_t, const EllipsoidType&)> add_children = [&](const size_t level,
+                                                                         const EllipsoidType& parent) {
+      if (level > max_depth)
         return;
-      for (const auto unused_counter : DSC::valueRange(children)) {
-        EllipsoidType child = parent;
-        const double scale  = std::pow(ellipsoid_cfg.get("ellipsoids.recursion_scale", 0.5), current_level);
-        const auto displace = [&](DomainFieldType& coord) {
-          const auto disp   = dist_rng() * DSC::signum(sign_rng());
-          coord += disp;
-          DSC_LOG_DEBUG_0 << disp << ";";
-        };
-        std::for_each(child.center.begin(), child.center.end(), displace);
-        std::generate(child.radii.begin(), child.radii.end(), [&radii_rng, scale]() { return radii_rng() * scale; });
-        ellipsoids_.push_back(child);
-        recurse_add(current_level + 1, child);
+      const DomainFieldType scale = std::pow(recursion_scale, level);
+      for (size_t cc = 0; cc < children; ++cc) {
+        EllipsoidType& child = *next++;
+        child                = parent;
+        for (auto& coord : child.center)
+          coord += displacement_distribution(engine) * (sign_distribution(engine) ? 1 : -1);
+        for (auto& radius : child.radii)
+          radius = radius_distribution(engine) * scale;
+        add_children(level + 1, child);
       }
     };
+    add_children(0, *ret);
+  } // ... generate_family(...)
 
-    for (auto ii : parent_range) {
-      recurse_add(0, ellipsoids_[ii]);
+  //! uses the given ellipsoids instead of generating them, only "ellipsoids.local_value" is used from ellipsoid_cfg
+  RandomEllipsoidsFunction(const Common::FieldVector<DomainFieldType, dimDomain>& lowerLeft,
+                           const Common::FieldVector<DomainFieldType, dimDomain>& upperRight,
+                           std::vector<EllipsoidType>&& ellipsoids, const Stuff::Common::Configuration& ellipsoid_cfg,
+                           const std::string nm = static_id())
+    : lowerLeft_(lowerLeft)
+    , upperRight_(upperRight)
+    , name_(nm)
+    , ellipsoid_cfg_(ellipsoid_cfg)
+    , ellipsoids_(std::move(ellipsoids))
+  {
+    build_tree();
+  }
+
+  /**
+   * \brief Creates the function with the ellipsoids stored in filename instead of generating them, \sa save
+   * \note  Only the bounding volume hierarchy of the ellipsoids is rebuilt, which is far cheaper than generating them.
+   */
+  static std::unique_ptr<ThisType> load(const std::string& filename,
+                                        const Common::FieldVector<DomainFieldType, dimDomain>& lowerLeft,
+                                        const Common::FieldVector<DomainFieldType, dimDomain>& upperRight,
+                                        const Stuff::Common::Configuration& ellipsoid_cfg,
+                                        const std::string nm = static_id())
+  {
+    const Common::MappedArray<SnapshotRecord> mapped(filename, snapshot_tag());
+    std::vector<EllipsoidType> ellipsoids(mapped.size());
+    for (size_t ii = 0; ii < mapped.size(); ++ii) {
+      std::copy_n(mapped[ii].center, dimDomain, ellipsoids[ii].center.begin());
+      std::copy_n(mapped[ii].radii, dimDomain, ellipsoids[ii].radii.begin());
     }
-    DSC_LOG_DEBUG_0 << "generated " << ellipsoids_.size() << " of " << total_count << "\n";
-    to_file(*DSC::make_ofstream("ellipsoids.txt"));
+    return Common::make_unique<ThisType>(lowerLeft, upperRight, std::move(ellipsoids), ellipsoid_cfg, nm);
+  } // ... load(...)
+
+  /**
+   * \brief Writes the ellipsoids to filename (in a versioned binary format in native byte order), \sa load
+   * \return false, if the file could not be written
+   */
+  bool save(const std::string& filename) const
+  {
+    std::vector<SnapshotRecord> records(ellipsoids_.size());
+    for (size_t ii = 0; ii < ellipsoids_.size(); ++ii) {
+      std::copy_n(ellipsoids_[ii].center.begin(), dimDomain, records[ii].center);
+      std::copy_n(ellipsoids_[ii].radii.begin(), dimDomain, records[ii].radii);
+    }
+    return Common::MappedArray<SnapshotRecord>::write(filename, records.data(), records.size(), snapshot_tag());
   }
 
+  const std::vector<EllipsoidType>& ellipsoids() const { return ellipsoids_; }
+
   RandomEllipsoidsFunction(const ThisType& other) = default;
 
   ThisType& operator=(const ThisType& other) = delete;
@@ -223,49 +341,47 @@ public:
   }
 
 private:
-  std::tuple<typename EllipsoidType::DomainType, typename EllipsoidType::DomainType>
-      bounding_box(const EntityType& entity) const
+  // the binary layout of one ellipsoid, \sa save
+  struct SnapshotRecord
   {
-    typename EllipsoidType::DomainType ll, ur;
-    typedef Dune::Stuff::Common::MinMaxAvg<DomainFieldType> MinMaxAvgType;
-    std::array<MinMaxAvgType, dimDomain> coord_limits;
-    const auto& geo = entity.geometry();
-    for (auto i : DSC::valueRange(geo.corners())) {
-      const auto& corner(geo.corner(i));
-      for (size_t k = 0; k < dimDomain; ++k)
-        coord_limits[k](corner[k]);
-    }
-    for (auto ii : DSC::valueRange(dimDomain)) {
-      ll[ii] = coord_limits[ii].min();
-      ur[ii] = coord_limits[ii].max();
+    DomainFieldType center[dimDomain];
+    DomainFieldType radii[dimDomain];
+  };
 
-      return std::make_pair(std::move(ll), std::move(ur));
-    }
+  // increase the version whenever the layout of SnapshotRecord changes
+  static std::string snapshot_tag() { return "ellipsoids.v1." + std::to_string(dimDomain) + "d"; }
+
+  void build_tree()
+  {
+    std::vector<BoundingBoxType> bounding_boxes(ellipsoids_.size());
+    std::transform(ellipsoids_.begin(), ellipsoids_.end(), bounding_boxes.begin(), [](const EllipsoidType& ellipsoid) {
+      return ellipsoid.bounding_box();
+    });
+    tree_.build(bounding_boxes);
+  }
+
+  static BoundingBoxType bounding_box(const EntityType& entity)
+  {
+    BoundingBoxType ret;
+    const auto& geo = entity.geometry();
+    for (auto i : DSC::valueRange(geo.corners()))
+      ret.extend(geo.corner(i));
+    return ret;
   }
 
 public:
   virtual std::unique_ptr<LocalfunctionType> local_function(const EntityType& entity) const override
   {
     const auto local_value = DomainFieldType(ellipsoid_cfg_.get("ellipsoids.local_value", 1.));
-    // decide on the subdomain the center of the entity belongs to
-    const auto max_radius = ellipsoid_cfg_.get("ellipsoids.max_radius", 0.04);
-    typename EllipsoidType::DomainType ll, ur;
-    std::tie(ll, ur) = bounding_box(entity);
-    std::for_each(ll.begin(), ll.end(), [&max_radius](DomainFieldType& lc) { lc -= 1.1 * max_radius; });
-    std::for_each(ur.begin(), ur.end(), [&max_radius](DomainFieldType& uc) { uc += 1.1 * max_radius; });
-    std::vector<EllipsoidType> local_ellipsoids;
-    for (const auto& ellipsoid : ellipsoids_) {
-      bool inside = true;
-      for (auto ii : DSC::valueRange(dimDomain)) {
-        inside = inside && DSC::FloatCmp::ge(ellipsoid.center[ii], ll[ii]);
-        inside = inside && DSC::FloatCmp::le(ellipsoid.center[ii], ur[ii]);
-      }
-      if (inside) {
-        local_ellipsoids.push_back(ellipsoid);
-      }
-    }
-    std::vector<EllipsoidType> tmp = ellipsoids_;
-    return std::unique_ptr<Localfunction>(new Localfunction(entity, local_value, std::move(tmp)));
+    // only consider the ellipsoids intersecting the bounding box of the entity
+    const auto entity_box = bounding_box(entity);
+    std::vector<const EllipsoidType*> local_ellipsoids;
+    tree_.for_each_intersecting(entity_box, [&](const size_t ii) {
+      if (ellipsoids_[ii].intersects_cube(entity_box.lower_left, entity_box.upper_right))
+        local_ellipsoids.push_back(&ellipsoids_[ii]);
+      return true;
+    });
+    return Common::make_unique<Localfunction>(entity, local_value, std::move(local_ellipsoids));
   } // ... local_function(...)
 
 private:
@@ -274,6 +390,7 @@ private:
   const std::string name_;
   const Stuff::Common::Configuration ellipsoid_cfg_;
   std::vector<EllipsoidType> ellipsoids_;
+  BoundingBoxTreeType tree_;
 }; // class RandomEllipsoidsFunction
 
 } // namespace Functions
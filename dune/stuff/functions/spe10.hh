@@ -17,16 +17,10 @@
 #include <dune/stuff/common/type_utils.hh>
 
 #include "checkerboard.hh"
+#include "spe10data.hh"
 
 namespace Dune {
 namespace Stuff {
-namespace Exceptions {
-
-class spe10_data_file_missing : public Dune::IOError
-{
-};
-
-} // namespace Exceptions
 namespace Functions {
 namespace Spe10 {
 namespace internal {
@@ -41,10 +35,15 @@ static const double model_1_length_z     = 15.24;
 static const double model1_min_value     = 0.001;
 static const double model1_max_value     = 998.915;
 
+// only the scalar permeability is stored per cell, which is expanded to a multiple of the identity on evaluation
 template <class EntityImp, class DomainFieldImp, class RangeFieldImp, size_t r, size_t rC>
-class Model1Base : public Checkerboard<EntityImp, DomainFieldImp, 2, RangeFieldImp, r, rC>
+class Model1Base
+    : public Checkerboard<EntityImp, DomainFieldImp, 2, RangeFieldImp, r, rC,
+                          CheckerboardStorage::ScalarTimesIdentity<RangeFieldImp, r, rC>>
 {
-  typedef Checkerboard<EntityImp, DomainFieldImp, 2, RangeFieldImp, r, rC> BaseType;
+  typedef Checkerboard<EntityImp, DomainFieldImp, 2, RangeFieldImp, r, rC,
+                       CheckerboardStorage::ScalarTimesIdentity<RangeFieldImp, r, rC>>
+      BaseType;
 
 public:
   typedef typename BaseType::EntityType EntityType;
@@ -53,6 +52,7 @@ public:
   typedef typename BaseType::DomainType DomainType;
   typedef typename BaseType::RangeFieldType RangeFieldType;
   typedef typename BaseType::RangeType RangeType;
+  typedef typename BaseType::StoredType StoredType;
 
   static const bool available = true;
 
@@ -63,32 +63,21 @@ public:
   } // ... static_id(...)
 
 private:
-  static std::vector<RangeType> read_values_from_file(const std::string& filename, const RangeFieldType& min,
-                                                      const RangeFieldType& max, const RangeType& unit_range)
+  static std::shared_ptr<const std::vector<StoredType>>
+  read_values_from_file(const std::string& filename, const RangeFieldType& min, const RangeFieldType& max)
 
   {
     if (!(max > min))
       DUNE_THROW(Dune::RangeError, "max (is " << max << ") has to be larger than min (is " << min << ")!");
     const RangeFieldType scale = (max - min) / (internal::model1_max_value - internal::model1_min_value);
     const RangeFieldType shift = min - scale * internal::model1_min_value;
-    // read all the data from the file
-    std::ifstream datafile(filename);
-    if (datafile.is_open()) {
-      static const size_t entriesPerDim = model1_x_elements * model1_y_elements * model1_z_elements;
-      // create storage (there should be exactly 6000 values in the file, but we onyl read the first 2000)
-      std::vector<RangeType> data(entriesPerDim, unit_range);
-      double tmp     = 0;
-      size_t counter = 0;
-      while (datafile >> tmp && counter < entriesPerDim)
-        data[counter++] *= (tmp * scale) + shift;
-      datafile.close();
-      if (counter != entriesPerDim)
-        DUNE_THROW(Dune::IOError,
-                   "wrong number of entries in '" << filename << "' (are " << counter << ", should be " << entriesPerDim
-                                                  << ")!");
-      return data;
-    } else
-      DUNE_THROW(Exceptions::spe10_data_file_missing, "could not open '" << filename << "'!");
+    // there should be exactly 6000 values in the file, but we only need the first 2000
+    static const size_t entriesPerDim = model1_x_elements * model1_y_elements * model1_z_elements;
+    const auto raw_data = Data::get(filename, entriesPerDim);
+    auto data = std::make_shared<std::vector<StoredType>>(entriesPerDim);
+    for (size_t ii = 0; ii < entriesPerDim; ++ii)
+      (*data)[ii] = ((*raw_data)[ii] * scale) + shift;
+    return data;
   } // ... read_values_from_file(...)
 
 public:
@@ -127,9 +116,9 @@ public:
   } // ... create(...)
 
   Model1Base(const std::string& filename, const DomainType& lowerLeft, const DomainType& upperRight,
-             const RangeFieldType min, const RangeFieldType max, const std::string nm, const RangeType& unit_range)
+             const RangeFieldType min, const RangeFieldType max, const std::string nm)
     : BaseType(lowerLeft, upperRight, {model1_x_elements, model1_z_elements},
-               read_values_from_file(filename, min, max, unit_range), nm)
+               read_values_from_file(filename, min, max), nm)
   {
   }
 
@@ -171,30 +160,9 @@ public:
          const Common::FieldVector<DomainFieldType, dimDomain>& upper_right,
          const RangeFieldType min = internal::model1_min_value, const RangeFieldType max = internal::model1_max_value,
          const std::string nm = BaseType::static_id())
-    : BaseType(filename, lower_left, upper_right, min, max, nm, unit_matrix())
+    : BaseType(filename, lower_left, upper_right, min, max, nm)
   {
   }
-
-private:
-  template <size_t d, bool anything = true>
-  struct Call
-  {
-    static RangeType unit_matrix()
-    {
-      RangeType ret(0.0);
-      for (size_t rr = 0; rr < r; ++rr)
-        ret[rr][rr] = 1.0;
-      return ret;
-    }
-  };
-
-  template <bool anything>
-  struct Call<1, anything>
-  {
-    static RangeType unit_matrix() { return RangeType(1); }
-  };
-
-  static RangeType unit_matrix() { return Call<r>::unit_matrix(); }
 }; // class Model1< ..., 2, ..., r, r >
 
 } // namespace Spe10
@@ -0,0 +1,155 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff/
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_FUNCTIONS_SPE10DATA_HH
+#define DUNE_STUFF_FUNCTIONS_SPE10DATA_HH
+
+#include <cassert>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/unused.hh>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/common/mapped-array.hh>
+#include <dune/stuff/common/memory.hh>
+
+namespace Dune {
+namespace Stuff {
+namespace Exceptions {
+
+class spe10_data_file_missing : public Dune::IOError
+{
+};
+
+} // namespace Exceptions
+namespace Functions {
+namespace Spe10 {
+namespace internal {
+
+/**
+ * \brief The first num_values values of an (ASCII) SPE10 data file.
+ *
+ *        On first use, the ASCII file is parsed and converted to a binary file (see binary_filename()), which is then
+ *        memory mapped read-only. Subsequent runs (and all processes on the same node) only map the binary file, which
+ *        is regenerated if it is older than the ASCII file or contains too few values. If the binary file can not be
+ *        written (e.g. in a read-only directory), the parsed values are kept in memory instead.
+ *
+ *        Use get() to obtain the values, which loads each data file only once per process.
+ */
+class Data
+{
+public:
+  static std::string binary_filename(const std::string& filename) { return filename + ".bin"; }
+
+  /**
+   * \brief Returns the (at least) num_values values of filename, shared by all users within this process.
+   *
+   *        The values are loaded on first request and released once the last user is gone. Thread safe.
+   */
+  static std::shared_ptr<const Data> get(const std::string& filename, const size_t num_values)
+  {
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<const Data>> registry;
+    boost::system::error_code error;
+    auto path = boost::filesystem::canonical(filename, error);
+    if (error)
+      path = boost::filesystem::absolute(filename);
+    const std::string key = path.string();
+    std::lock_guard<std::mutex> DUNE_UNUSED(guard)(mutex);
+    auto& entry = registry[key];
+    auto data   = entry.lock();
+    if (!data || data->size() < num_values) {
+      data  = std::make_shared<Data>(filename, num_values);
+      entry = data;
+    }
+    return data;
+  } // ... get(...)
+
+  Data(const std::string& filename, const size_t num_values)
+    : size_(num_values)
+    , values_(nullptr)
+  {
+    const std::string cache_filename = binary_filename(filename);
+    if (!up_to_date(filename, cache_filename, num_values)) {
+      parsed_values_ = read_ascii(filename, num_values);
+      if (!Common::MappedArray<double>::write(cache_filename, parsed_values_.data(), parsed_values_.size())) {
+        values_ = parsed_values_.data();
+        return;
+      }
+      parsed_values_ = std::vector<double>();
+    }
+    mapped_values_ = Common::make_unique<Common::MappedArray<double>>(cache_filename);
+    values_        = mapped_values_->data();
+  } // Data(...)
+
+  Data(const Data& other) = delete;
+
+  Data& operator=(const Data& other) = delete;
+
+  size_t size() const { return size_; }
+
+  const double* data() const { return values_; }
+
+  double operator[](const size_t ii) const
+  {
+    assert(ii < size_);
+    return values_[ii];
+  }
+
+  //! true if the values are memory mapped, false if they had to be kept in memory
+  bool mapped() const { return bool(mapped_values_); }
+
+private:
+  static bool up_to_date(const std::string& filename, const std::string& cache_filename, const size_t num_values)
+  {
+    if (!Common::MappedArray<double>::is_valid(cache_filename, num_values))
+      return false;
+    // allow to use the binary file on its own
+    boost::system::error_code error;
+    const auto source_time = boost::filesystem::last_write_time(filename, error);
+    if (error)
+      return true;
+    const auto cache_time = boost::filesystem::last_write_time(cache_filename, error);
+    return !error && cache_time >= source_time;
+  } // ... up_to_date(...)
+
+  static std::vector<double> read_ascii(const std::string& filename, const size_t num_values)
+  {
+    std::ifstream datafile(filename);
+    if (!datafile.is_open())
+      DUNE_THROW(Exceptions::spe10_data_file_missing, "could not open '" << filename << "'!");
+    std::vector<double> values(num_values);
+    size_t counter = 0;
+    double tmp     = 0;
+    while (counter < num_values && datafile >> tmp)
+      values[counter++] = tmp;
+    if (counter != num_values)
+      DUNE_THROW(Dune::IOError,
+                 "wrong number of entries in '" << filename << "' (are " << counter << ", should be at least "
+                                                << num_values << ")!");
+    return values;
+  } // ... read_ascii(...)
+
+  const size_t size_;
+  std::vector<double> parsed_values_;
+  std::unique_ptr<const Common::MappedArray<double>> mapped_values_;
+  const double* values_;
+}; // class Data
+
+} // namespace internal
+} // namespace Spe10
+} // namespace Functions
+} // namespace Stuff
+} // namespace Dune
+
+#endif // DUNE_STUFF_FUNCTIONS_SPE10DATA_HH
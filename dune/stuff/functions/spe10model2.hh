@@ -16,6 +16,7 @@
 #include <dune/stuff/common/fvector.hh>
 #include <dune/stuff/common/type_utils.hh>
 #include <dune/stuff/functions/global.hh>
+#include <dune/stuff/functions/spe10data.hh>
 
 namespace Dune {
 namespace Stuff {
@@ -38,7 +39,6 @@ public:
   Model2(std::string data_filename = "perm_case2a.dat",
          DSC::FieldVector<double, dim_domain> upper_right = default_upper_right)
     : deltas_{{upper_right[0] / num_elements[0], upper_right[1] / num_elements[1], upper_right[2] / num_elements[2]}}
-    , permeability_(nullptr)
     , permMatrix_(0.0)
     , filename_(data_filename)
   {
@@ -49,12 +49,6 @@ public:
   // unsigned int mandated by CubeGrid provider
   static const DSC::FieldVector<unsigned int, dim_domain> num_elements;
 
-  virtual ~Model2()
-  {
-    delete permeability_;
-    permeability_ = nullptr;
-  }
-
   //! currently used in gdt assembler
   virtual void evaluate(const typename BaseType::DomainType& x,
                         typename BaseType::RangeType& diffusion) const final override
@@ -77,34 +71,27 @@ public:
     const int offset = permIntervalls_[0] + permIntervalls_[1] * num_elements[0]
                        + permIntervalls_[2] * num_elements[1] * num_elements[0];
     for (size_t dim = 0; dim < dim_domain; ++dim) {
-      const auto idx      = offset + dim * 1122000;
-      diffusion[dim][dim] = permeability_[idx];
+      const auto idx      = offset + dim * num_values_per_dim;
+      diffusion[dim][dim] = (*permeability_)[idx];
     }
   }
 
   virtual size_t order() const override { return 0u; }
 
 private:
+  static const size_t num_values_per_dim = 60 * 220 * 85;
+
   void readPermeability()
   {
-    std::ifstream file(filename_);
-    double val;
-    if (!file) { // file couldn't be opened
-      return;
-    }
-    file >> val;
-    int counter   = 0;
-    permeability_ = new double[3366000];
-    while (!file.eof()) {
-      // keep reading until end-of-file
-      permeability_[counter++] = val;
-      file >> val; // sets EOF flag if no value found
+    try {
+      permeability_ = internal::Data::get(filename_, dim_domain * num_values_per_dim);
+    } catch (Exceptions::spe10_data_file_missing&) {
+      // evaluate() reports the missing file
     }
-    file.close();
   }
 
   std::array<double, dim_domain> deltas_;
-  double* permeability_; //! TODO automatic memory
+  std::shared_ptr<const internal::Data> permeability_;
   mutable typename BaseType::DomainType permIntervalls_;
   mutable Dune::FieldMatrix<double, BaseType::DomainType::dimension, BaseType::DomainType::dimension> permMatrix_;
   const std::string filename_;
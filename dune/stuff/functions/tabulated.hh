@@ -0,0 +1,391 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_FUNCTIONS_TABULATED_HH
+#define DUNE_STUFF_FUNCTIONS_TABULATED_HH
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#if HAVE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <dune/geometry/referenceelements.hh>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/common/fvector.hh>
+#include <dune/stuff/common/unused.hh>
+#include <dune/stuff/grid/walker.hh>
+
+#include "interfaces.hh"
+
+namespace Dune {
+namespace Stuff {
+namespace Functions {
+
+/**
+ * \brief Tabulates a given function on a structured lattice and interpolates the tabulated values.
+ *
+ *        The given function is evaluated once on num_points[ii] equidistant points in each direction of the box
+ *        [lower_left, upper_right] (optionally in parallel), afterwards each evaluation is a multilinear or cubic
+ *        (Catmull-Rom) interpolation of the tabulated values. Points outside the box are projected onto it. To judge
+ *        if the resolution suffices, max_interpolation_error() reports the maximum difference (in the infinity norm)
+ *        of the function and its interpolation in the centers of all lattice cells.
+ *
+ *        Global functions can be tabulated on any box, localizable functions are tabulated on the elements of a given
+ *        grid view, which have to cover the box.
+ *
+ * \note  Only values can be interpolated, jacobian() is not available.
+ */
+template <class EntityImp, class DomainFieldImp, size_t domainDim, class RangeFieldImp, size_t rangeDim,
+          size_t rangeDimCols = 1>
+class Tabulated
+    : public GlobalFunctionInterface<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols>
+{
+  typedef GlobalFunctionInterface<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols> BaseType;
+  typedef Tabulated<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols> ThisType;
+
+public:
+  typedef typename BaseType::EntityType EntityType;
+  typedef typename BaseType::DomainFieldType DomainFieldType;
+  static const size_t dimDomain = BaseType::dimDomain;
+  typedef typename BaseType::DomainType DomainType;
+  typedef typename BaseType::RangeFieldType RangeFieldType;
+  typedef typename BaseType::RangeType RangeType;
+
+  typedef GlobalFunctionInterface<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols>
+      GlobalFunctionType;
+  typedef LocalizableFunctionInterface<EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols>
+      LocalizableFunctionType;
+  typedef Common::FieldVector<size_t, dimDomain> NumPointsType;
+
+  enum class Interpolation
+  {
+    multilinear,
+    cubic
+  }; // enum class Interpolation
+
+private:
+  // equidistant points origin + ii * spacing, ii < count, in each direction
+  struct Lattice
+  {
+    Lattice(const DomainType& orig, const DomainType& space, const NumPointsType& cnt)
+      : origin(orig)
+      , spacing(space)
+      , count(cnt)
+    {
+    }
+
+    size_t size() const
+    {
+      size_t ret = 1;
+      for (size_t dd = 0; dd < dimDomain; ++dd)
+        ret *= count[dd];
+      return ret;
+    }
+
+    DomainType point(size_t index) const
+    {
+      DomainType ret;
+      for (size_t dd = 0; dd < dimDomain; ++dd) {
+        ret[dd] = origin[dd] + DomainFieldType(index % count[dd]) * spacing[dd];
+        index /= count[dd];
+      }
+      return ret;
+    }
+
+    DomainType origin;
+    DomainType spacing;
+    NumPointsType count;
+  }; // struct Lattice
+
+public:
+  static std::string static_id() { return BaseType::static_id() + ".tabulated"; }
+
+  //! tabulates a global function
+  Tabulated(const GlobalFunctionType& function, const DomainType& lower_left, const DomainType& upper_right,
+            const NumPointsType& num_points, const Interpolation interpolation = Interpolation::multilinear,
+            const bool use_tbb = false, const std::string nm = static_id())
+    : lower_left_(lower_left)
+    , spacing_(spacing(lower_left, upper_right, num_points))
+    , num_points_(num_points)
+    , interpolation_(interpolation)
+    , order_(function.order())
+    , name_(nm)
+  {
+    const auto evaluate = [&](const DomainType& xx) { return function.evaluate(xx); };
+    values_ = sample(nodes(), evaluate, use_tbb);
+    compute_max_interpolation_error(sample(cell_centers(), evaluate, use_tbb));
+  }
+
+#if HAVE_DUNE_GRID
+  //! tabulates a localizable function, the elements of grid_view have to cover the box
+  template <class GridViewType>
+  Tabulated(const GridViewType& grid_view, const LocalizableFunctionType& function, const DomainType& lower_left,
+            const DomainType& upper_right, const NumPointsType& num_points,
+            const Interpolation interpolation = Interpolation::multilinear, const bool use_tbb = false,
+            const std::string nm = static_id())
+    : lower_left_(lower_left)
+    , spacing_(spacing(lower_left, upper_right, num_points))
+    , num_points_(num_points)
+    , interpolation_(interpolation)
+    , order_(0)
+    , name_(nm)
+  {
+    static_assert(std::is_same<typename GridViewType::template Codim<0>::Entity, EntityType>::value,
+                  "The function has to be localizable w.r.t. the elements of the grid view!");
+    values_ = sample(grid_view, function, nodes(), use_tbb);
+    compute_max_interpolation_error(sample(grid_view, function, cell_centers(), use_tbb));
+  }
+#endif // HAVE_DUNE_GRID
+
+  virtual std::string type() const override final { return static_id(); }
+
+  virtual std::string name() const override final { return name_; }
+
+  //! the order of the interpolation (or of the tabulated function, if lower)
+  virtual size_t order() const override final
+  {
+    return std::min(order_, (interpolation_ == Interpolation::cubic ? 3 : 1) * dimDomain);
+  }
+
+  using BaseType::evaluate;
+
+  virtual void evaluate(const DomainType& xx, RangeType& ret) const override final
+  {
+    std::array<size_t, dimDomain> base;
+    std::array<DomainFieldType, dimDomain> frac;
+    for (size_t dd = 0; dd < dimDomain; ++dd) {
+      const DomainFieldType tt = std::min(std::max((xx[dd] - lower_left_[dd]) / spacing_[dd], DomainFieldType(0)),
+                                          DomainFieldType(num_points_[dd] - 1));
+      base[dd] = std::min(size_t(std::floor(tt)), num_points_[dd] - 2);
+      frac[dd] = tt - DomainFieldType(base[dd]);
+    }
+    ret = RangeFieldType(0);
+    if (interpolation_ == Interpolation::multilinear)
+      interpolate<2>(base, frac, ret, [](const int offset, const DomainFieldType tt) {
+        return offset == 0 ? 1 - tt : tt;
+      });
+    else
+      interpolate<4>(base, frac, ret, [](const int offset, const DomainFieldType tt) {
+        // the Catmull-Rom weights of the points base - 1, ..., base + 2
+        const DomainFieldType t2 = tt * tt;
+        const DomainFieldType t3 = t2 * tt;
+        switch (offset) {
+          case -1:
+            return 0.5 * (-t3 + 2 * t2 - tt);
+          case 0:
+            return 0.5 * (3 * t3 - 5 * t2 + 2);
+          case 1:
+            return 0.5 * (-3 * t3 + 4 * t2 + tt);
+          default:
+            return 0.5 * (t3 - t2);
+        }
+      });
+  } // ... evaluate(...)
+
+  //! the maximum difference of the function and its interpolation in the centers of the lattice cells
+  RangeFieldType max_interpolation_error() const { return max_interpolation_error_; }
+
+  const NumPointsType& num_points() const { return num_points_; }
+
+  //! the tabulated values, ordered lexicographically with the first direction running fastest
+  const std::vector<RangeType>& values() const { return values_; }
+
+private:
+  static DomainType spacing(const DomainType& lower_left, const DomainType& upper_right,
+                            const NumPointsType& num_points)
+  {
+    DomainType ret;
+    for (size_t dd = 0; dd < dimDomain; ++dd) {
+      if (!(upper_right[dd] > lower_left[dd]))
+        DUNE_THROW(Exceptions::wrong_input_given,
+                   "upper_right has to be greater than lower_left (is " << upper_right << " and " << lower_left
+                                                                        << ")!");
+      if (num_points[dd] < 2)
+        DUNE_THROW(Exceptions::wrong_input_given,
+                   "At least 2 points are required in each direction (is " << num_points << ")!");
+      ret[dd] = (upper_right[dd] - lower_left[dd]) / DomainFieldType(num_points[dd] - 1);
+    }
+    return ret;
+  } // ... spacing(...)
+
+  Lattice nodes() const { return Lattice(lower_left_, spacing_, num_points_); }
+
+  Lattice cell_centers() const
+  {
+    DomainType origin = lower_left_;
+    NumPointsType count;
+    for (size_t dd = 0; dd < dimDomain; ++dd) {
+      origin[dd] += 0.5 * spacing_[dd];
+      count[dd] = num_points_[dd] - 1;
+    }
+    return Lattice(origin, spacing_, count);
+  } // ... cell_centers(...)
+
+  template <class EvaluationType>
+  static std::vector<RangeType> sample(const Lattice& lattice, const EvaluationType& evaluate, const bool use_tbb)
+  {
+    std::vector<RangeType> ret(lattice.size());
+#if HAVE_TBB
+    if (use_tbb) {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, ret.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t ii = range.begin(); ii != range.end(); ++ii)
+          ret[ii] = evaluate(lattice.point(ii));
+      });
+      return ret;
+    }
+#else
+    const auto DSC_UNUSED(no_warning_for_use_tbb) = use_tbb;
+#endif
+    for (size_t ii = 0; ii < ret.size(); ++ii)
+      ret[ii] = evaluate(lattice.point(ii));
+    return ret;
+  } // ... sample(...)
+
+#if HAVE_DUNE_GRID
+  template <class GridViewType>
+  std::vector<RangeType> sample(const GridViewType& grid_view, const LocalizableFunctionType& function,
+                                const Lattice& lattice, const bool use_tbb)
+  {
+    std::vector<RangeType> ret(lattice.size());
+    // points on the boundary of several elements are evaluated only once (by the first thread to claim them)
+    std::vector<std::atomic<bool>> claimed(lattice.size());
+    for (auto& flag : claimed)
+      flag = false;
+    std::atomic<size_t> max_order(0);
+    Grid::Walker<GridViewType> walker(grid_view);
+    walker.add([&](const EntityType& entity) {
+      const auto local_function = function.local_function(entity);
+      size_t current_max_order = max_order;
+      while (local_function->order() > current_max_order
+             && !max_order.compare_exchange_weak(current_max_order, local_function->order()))
+        ;
+      const auto& geometry          = entity.geometry();
+      const auto& reference_element = ReferenceElements<DomainFieldType, dimDomain>::general(entity.type());
+      // the range of lattice points within the bounding box of the entity
+      std::array<size_t, dimDomain> first;
+      std::array<size_t, dimDomain> count;
+      for (size_t dd = 0; dd < dimDomain; ++dd) {
+        DomainFieldType min = geometry.corner(0)[dd];
+        DomainFieldType max = min;
+        for (int cc = 1; cc < geometry.corners(); ++cc) {
+          min = std::min(min, geometry.corner(cc)[dd]);
+          max = std::max(max, geometry.corner(cc)[dd]);
+        }
+        const DomainFieldType tol = 1e-10 * lattice.spacing[dd];
+        const auto lower =
+            std::max(std::ceil((min - lattice.origin[dd] - tol) / lattice.spacing[dd]), DomainFieldType(0));
+        const auto upper = std::min(std::floor((max - lattice.origin[dd] + tol) / lattice.spacing[dd]),
+                                    DomainFieldType(lattice.count[dd]) - 1);
+        if (upper < lower)
+          return;
+        first[dd] = size_t(lower);
+        count[dd] = size_t(upper - lower) + 1;
+      }
+      size_t num_candidates = 1;
+      for (size_t dd = 0; dd < dimDomain; ++dd)
+        num_candidates *= count[dd];
+      for (size_t candidate = 0; candidate < num_candidates; ++candidate) {
+        size_t index  = 0;
+        size_t stride = 1;
+        size_t rest   = candidate;
+        for (size_t dd = 0; dd < dimDomain; ++dd) {
+          index += (first[dd] + rest % count[dd]) * stride;
+          rest /= count[dd];
+          stride *= lattice.count[dd];
+        }
+        const auto xx_local = geometry.local(lattice.point(index));
+        if (reference_element.checkInside(xx_local) && !claimed[index].exchange(true))
+          local_function->evaluate(xx_local, ret[index]);
+      }
+    });
+    walker.walk(use_tbb);
+    for (const auto& flag : claimed)
+      if (!flag)
+        DUNE_THROW(Exceptions::wrong_input_given, "The given grid view does not cover the box to tabulate on!");
+    order_ = std::max(order_, size_t(max_order));
+    return ret;
+  } // ... sample(...)
+#endif // HAVE_DUNE_GRID
+
+  void compute_max_interpolation_error(const std::vector<RangeType>& values_in_cell_centers)
+  {
+    const auto centers        = cell_centers();
+    max_interpolation_error_ = 0;
+    RangeType difference(0);
+    for (size_t ii = 0; ii < values_in_cell_centers.size(); ++ii) {
+      evaluate(centers.point(ii), difference);
+      difference -= values_in_cell_centers[ii];
+      max_interpolation_error_ = std::max(max_interpolation_error_, RangeFieldType(difference.infinity_norm()));
+    }
+  } // ... compute_max_interpolation_error(...)
+
+  /**
+   * Adds the weighted values of the num_points^dimDomain points around base to ret, the point base + offset is
+   * weighted by the product of weight(offset[dd], frac[dd]), where offset[dd] runs from 1 - num_points / 2. Values of
+   * points outside of the lattice are linearly extrapolated from the two closest ones.
+   */
+  template <int num_points, class WeightType>
+  void interpolate(const std::array<size_t, dimDomain>& base, const std::array<DomainFieldType, dimDomain>& frac,
+                   RangeType& ret, const WeightType& weight) const
+  {
+    static const int first_offset = 1 - num_points / 2;
+    std::array<std::array<DomainFieldType, num_points>, dimDomain> weights;
+    for (size_t dd = 0; dd < dimDomain; ++dd) {
+      for (int ii = 0; ii < num_points; ++ii)
+        weights[dd][ii] = weight(first_offset + ii, frac[dd]);
+      // the stencil is at most one point too wide, fold the weight of the outside point onto the two next ones
+      for (int ii = 0; ii < num_points; ++ii) {
+        const int index = int(base[dd]) + first_offset + ii;
+        const int inner = (index < 0) ? 1 : ((index >= int(num_points_[dd])) ? -1 : 0);
+        if (inner != 0) {
+          weights[dd][ii + inner] += 2 * weights[dd][ii];
+          weights[dd][ii + 2 * inner] -= weights[dd][ii];
+          weights[dd][ii] = 0;
+        }
+      }
+    }
+    size_t num_stencil_points = 1;
+    for (size_t dd = 0; dd < dimDomain; ++dd)
+      num_stencil_points *= num_points;
+    for (size_t point = 0; point < num_stencil_points; ++point) {
+      DomainFieldType point_weight = 1;
+      size_t index  = 0;
+      size_t stride = 1;
+      size_t rest   = point;
+      for (size_t dd = 0; dd < dimDomain; ++dd) {
+        const int ii = int(rest % num_points);
+        rest /= num_points;
+        point_weight *= weights[dd][ii];
+        index += (base[dd] + ii + first_offset) * stride;
+        stride *= num_points_[dd];
+      }
+      if (point_weight != 0)
+        ret.axpy(point_weight, values_[index]);
+    }
+  } // ... interpolate(...)
+
+  const DomainType lower_left_;
+  const DomainType spacing_;
+  const NumPointsType num_points_;
+  const Interpolation interpolation_;
+  size_t order_;
+  const std::string name_;
+  std::vector<RangeType> values_;
+  RangeFieldType max_interpolation_error_;
+}; // class Tabulated
+
+} // namespace Functions
+} // namespace Stuff
+} // namespace Dune
+
+#endif // DUNE_STUFF_FUNCTIONS_TABULATED_HH
@@ -0,0 +1,134 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_GRID_BOUNDARYINFO_PRECOMPUTED_HH
+#define DUNE_STUFF_GRID_BOUNDARYINFO_PRECOMPUTED_HH
+
+// nothing here will compile w/o grid present
+#if HAVE_DUNE_GRID
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <dune/stuff/common/ranges.hh>
+#include <dune/stuff/grid/boundaryinfo.hh>
+#include <dune/stuff/grid/entity.hh>
+#include <dune/stuff/grid/walker.hh>
+
+namespace Dune {
+namespace Stuff {
+namespace Grid {
+namespace BoundaryInfos {
+
+/**
+ * \brief Classifies all boundary intersections of a grid view once and answers all queries by a table lookup.
+ *
+ *        The type of each face is stored in a flat array, addressed by the index of its entity and its local index in
+ *        this entity. Thus dirichlet() and neumann() cost an index computation instead of, e.g., the normal
+ *        comparisons of NormalBased or the map lookups of IdBased. The classification walks the grid view in parallel
+ *        if use_tbb is true, which requires dirichlet() and neumann() of the given boundary info to be thread safe.
+ * \note  Only intersections of the given grid view may be queried. The given boundary info is not used after the
+ *        construction.
+ */
+template <class GridViewImp>
+class Precomputed : public BoundaryInfoInterface<typename GridViewImp::Intersection>
+{
+  typedef BoundaryInfoInterface<typename GridViewImp::Intersection> BaseType;
+  typedef Precomputed<GridViewImp> ThisType;
+
+public:
+  typedef GridViewImp GridViewType;
+  using typename BaseType::IntersectionType;
+  typedef typename Stuff::Grid::Entity<GridViewType>::Type EntityType;
+  typedef typename GridViewType::IndexSet::IndexType EntityIndexType;
+
+  static const std::string static_id() { return internal::boundary_info_static_id() + ".precomputed"; }
+
+  Precomputed(const GridViewType& grid_view, const BaseType& boundary_info, const bool use_tbb = false)
+    : grid_view_(grid_view)
+    , has_dirichlet_(boundary_info.has_dirichlet())
+    , has_neumann_(boundary_info.has_neumann())
+    , offsets_(grid_view_.indexSet().size(0) + 1, 0)
+  {
+    // the faces of the entity with index ii are [offsets_[ii], offsets_[ii + 1])
+    for (const auto& entity : DSC::entityRange(grid_view_))
+      offsets_[grid_view_.indexSet().index(entity) + 1] = DSG::reference_element(entity).size(1);
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+    types_.assign(offsets_.back(), 0);
+    // each intersection only writes its own entry
+    Walker<GridViewType> walker(grid_view_);
+    walker.add(
+        [&](const IntersectionType& intersection, const EntityType& inside, const EntityType& /*outside*/) {
+          auto& type = types_[offsets_[grid_view_.indexSet().index(inside)] + intersection.indexInInside()];
+          if (boundary_info.dirichlet(intersection))
+            type |= dirichlet_type;
+          if (boundary_info.neumann(intersection))
+            type |= neumann_type;
+        },
+        new ApplyOn::BoundaryIntersections<GridViewType>());
+    walker.walk(use_tbb);
+  } // Precomputed(...)
+
+  virtual ~Precomputed() {}
+
+  const GridViewType& grid_view() const { return grid_view_; }
+
+  virtual bool has_dirichlet() const override final { return has_dirichlet_; }
+
+  virtual bool has_neumann() const override final { return has_neumann_; }
+
+  virtual bool dirichlet(const IntersectionType& intersection) const override final
+  {
+    return intersection.boundary() && dirichlet(grid_view_.indexSet().index(intersection.inside()),
+                                                intersection.indexInInside());
+  }
+
+  virtual bool neumann(const IntersectionType& intersection) const override final
+  {
+    return intersection.boundary() && neumann(grid_view_.indexSet().index(intersection.inside()),
+                                              intersection.indexInInside());
+  }
+
+  //! \param local_face the index of the face in the entity, i.e. intersection.indexInInside()
+  bool dirichlet(const EntityIndexType entity_index, const int local_face) const
+  {
+    return (types_[offsets_[entity_index] + local_face] & dirichlet_type) != 0;
+  }
+
+  //! \sa dirichlet
+  bool neumann(const EntityIndexType entity_index, const int local_face) const
+  {
+    return (types_[offsets_[entity_index] + local_face] & neumann_type) != 0;
+  }
+
+private:
+  static const unsigned char dirichlet_type = 1;
+  static const unsigned char neumann_type   = 2;
+
+  const GridViewType grid_view_;
+  const bool has_dirichlet_;
+  const bool has_neumann_;
+  std::vector<size_t> offsets_;
+  std::vector<unsigned char> types_;
+}; // class Precomputed
+
+template <class GridViewType>
+Precomputed<GridViewType>
+make_precomputed(const GridViewType& grid_view,
+                 const BoundaryInfoInterface<typename GridViewType::Intersection>& boundary_info,
+                 const bool use_tbb = false)
+{
+  return Precomputed<GridViewType>(grid_view, boundary_info, use_tbb);
+}
+
+} // namespace BoundaryInfos
+} // namespace Grid
+} // namespace Stuff
+} // namespace Dune
+
+#endif // HAVE_DUNE_GRID
+
+#endif // DUNE_STUFF_GRID_BOUNDARYINFO_PRECOMPUTED_HH
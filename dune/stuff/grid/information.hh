@@ -6,6 +6,8 @@
 #ifndef DUNE_STUFF_GRID_INFORMATION_HH
 #define DUNE_STUFF_GRID_INFORMATION_HH
 
+#include <array>
+#include <limits>
 #include <ostream>
 
 #include <boost/format.hpp>
@@ -18,6 +20,7 @@
 #endif
 
 #include <dune/stuff/common/math.hh>
+#include <dune/stuff/common/parallel/threadstorage.hh>
 #include <dune/stuff/grid/intersection.hh>
 #include <dune/stuff/common/ranges.hh>
 #include <dune/stuff/grid/walker.hh>
@@ -31,6 +34,116 @@ namespace Grid {
 
 #if HAVE_DUNE_GRID
 
+/**
+ * \brief Statistics of a grid view, computed in a single walk over all entities and their intersections.
+ *
+ *        The walk may be parallel, each thread then fills its own record and the records are combined using
+ *        operator+= at the end, \sa statistics()
+ */
+template <class GridViewType>
+struct GridStatistics
+{
+  typedef GridStatistics<GridViewType> ThisType;
+  typedef typename GridViewType::ctype DomainFieldType;
+  static const size_t dimDomain = GridViewType::dimension;
+  static const size_t dimWorld  = GridViewType::dimensionworld;
+  typedef Common::MinMaxAvg<DomainFieldType> MinMaxAvgType;
+  typedef typename Stuff::Grid::Entity<GridViewType>::Type EntityType;
+
+  size_t num_entities;
+  size_t num_intersections;
+  //! neighbor() && !boundary()
+  size_t num_inner_intersections;
+  //! !neighbor() && boundary()
+  size_t num_boundary_intersections;
+  //! neighbor() && boundary()
+  size_t num_periodic_intersections;
+  MinMaxAvgType entity_volume;
+  //! the diameter of the entities
+  MinMaxAvgType entity_width;
+  //! the ratio of the longest to the shortest edge of the entities
+  MinMaxAvgType entity_aspect_ratio;
+  //! the number of intersections of the entities
+  Common::MinMaxAvg<double> entity_neighbors;
+  MinMaxAvgType intersection_volume;
+  //! the bounding box of the grid view is given by the min() and max() of each coordinate
+  std::array<MinMaxAvgType, dimWorld> coord_limits;
+
+  GridStatistics()
+    : num_entities(0)
+    , num_intersections(0)
+    , num_inner_intersections(0)
+    , num_boundary_intersections(0)
+    , num_periodic_intersections(0)
+  {
+  }
+
+  void add(const GridViewType& grid_view, const EntityType& entity)
+  {
+    ++num_entities;
+    const auto geometry = entity.geometry();
+    entity_volume(geometry.volume());
+    entity_width(entity_diameter(entity));
+    for (int cc = 0; cc < geometry.corners(); ++cc) {
+      const auto corner = geometry.corner(cc);
+      for (size_t dd = 0; dd < dimWorld; ++dd)
+        coord_limits[dd](corner[dd]);
+    }
+    const auto& reference_element = DSG::reference_element(geometry);
+    DomainFieldType shortest_edge = std::numeric_limits<DomainFieldType>::max();
+    DomainFieldType longest_edge  = 0;
+    for (int ee = 0; ee < reference_element.size(dimDomain - 1); ++ee) {
+      auto edge = geometry.corner(reference_element.subEntity(ee, dimDomain - 1, 1, dimDomain));
+      edge -= geometry.corner(reference_element.subEntity(ee, dimDomain - 1, 0, dimDomain));
+      shortest_edge = std::min(shortest_edge, DomainFieldType(edge.two_norm()));
+      longest_edge  = std::max(longest_edge, DomainFieldType(edge.two_norm()));
+    }
+    entity_aspect_ratio(longest_edge / shortest_edge);
+    size_t neighbors = 0;
+    for (const auto& intersection : DSC::intersectionRange(grid_view, entity)) {
+      ++neighbors;
+      intersection_volume(intersection.geometry().volume());
+      num_inner_intersections += (intersection.neighbor() && !intersection.boundary());
+      num_boundary_intersections += (!intersection.neighbor() && intersection.boundary());
+      num_periodic_intersections += (intersection.neighbor() && intersection.boundary());
+    }
+    num_intersections += neighbors;
+    entity_neighbors(double(neighbors));
+  } // ... add(...)
+
+  ThisType& operator+=(const ThisType& other)
+  {
+    num_entities += other.num_entities;
+    num_intersections += other.num_intersections;
+    num_inner_intersections += other.num_inner_intersections;
+    num_boundary_intersections += other.num_boundary_intersections;
+    num_periodic_intersections += other.num_periodic_intersections;
+    entity_volume += other.entity_volume;
+    entity_width += other.entity_width;
+    entity_aspect_ratio += other.entity_aspect_ratio;
+    entity_neighbors += other.entity_neighbors;
+    intersection_volume += other.intersection_volume;
+    for (size_t dd = 0; dd < dimWorld; ++dd)
+      coord_limits[dd] += other.coord_limits[dd];
+    return *this;
+  } // ... operator+=(...)
+}; // struct GridStatistics
+
+//! computes all GridStatistics in a single walk, which is parallel if use_tbb is true
+template <class GridViewType>
+GridStatistics<GridViewType> statistics(const GridViewType& grid_view, const bool use_tbb = false)
+{
+  typedef GridStatistics<GridViewType> StatisticsType;
+  Common::PerThreadValue<StatisticsType> partial_statistics;
+  Walker<GridViewType> walker(grid_view);
+  walker.add([&](const typename StatisticsType::EntityType& entity) { partial_statistics->add(grid_view, entity); });
+  walker.walk(use_tbb);
+  return partial_statistics.accumulate(StatisticsType(), [](StatisticsType sum, const StatisticsType& partial) {
+    sum += partial;
+    return sum;
+  });
+} // ... statistics(...)
+
 struct Statistics
 {
   size_t numberOfEntities;
@@ -40,22 +153,18 @@ struct Statistics
   double maxGridWidth;
   template <class GridViewType>
   Statistics(const GridViewType& gridView)
-    : numberOfEntities(gridView.size(0))
-    , numberOfIntersections(0)
-    , numberOfInnerIntersections(0)
-    , numberOfBoundaryIntersections(0)
-    , maxGridWidth(0)
+    : Statistics(statistics(gridView))
+  {
+  }
+
+  template <class GridViewType>
+  Statistics(const GridStatistics<GridViewType>& st)
+    : numberOfEntities(st.num_entities)
+    , numberOfIntersections(st.num_intersections)
+    , numberOfInnerIntersections(st.num_inner_intersections)
+    , numberOfBoundaryIntersections(st.num_boundary_intersections)
+    , maxGridWidth(st.num_intersections > 0 ? st.intersection_volume.max() : 0)
   {
-    for (const auto& entity : DSC::entityRange(gridView)) {
-      for (const auto& intIt : DSC::intersectionRange(gridView, entity)) {
-        ++numberOfIntersections;
-        maxGridWidth = std::max(intIt.geometry().volume(), maxGridWidth);
-        // if we are inside the grid
-        numberOfInnerIntersections += (intIt.neighbor() && !intIt.boundary());
-        // if we are on the boundary of the grid
-        numberOfBoundaryIntersections += (!intIt.neighbor() && intIt.boundary());
-      }
-    }
   }
 };
 
@@ -73,8 +182,9 @@ void printInfo(const GridViewType& gridView, std::ostream& out)
 } // printGridInformation
 
 /**
-* \attention Not optimal, does a whole grid walk!
-**/
+ * \brief Only counts the intersections of each entity.
+ * \sa    statistics, which computes this along with further (geometric) quantities in the same walk
+ */
 template <class GridViewType>
 size_t maxNumberOfNeighbors(const GridViewType& gridView)
 {
@@ -89,7 +199,6 @@ size_t maxNumberOfNeighbors(const GridViewType& gridView)
   return maxNeighbours;
 } // size_t maxNumberOfNeighbors(const GridPartType& gridPart)
 
-
 //! Provide min/max coordinates for all space dimensions of a GridView
 template <class GridViewType>
 struct Dimensions
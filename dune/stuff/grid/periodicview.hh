@@ -8,8 +8,13 @@
 #ifndef DUNE_STUFF_GRID_PERIODICVIEW_HH
 #define DUNE_STUFF_GRID_PERIODICVIEW_HH
 
+#include <algorithm>
+#include <array>
 #include <bitset>
-#include <map>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -22,7 +27,6 @@
 #include <dune/stuff/common/memory.hh>
 #include <dune/stuff/common/float_cmp.hh>
 #include <dune/stuff/common/ranges.hh>
-#include <dune/stuff/grid/search.hh>
 
 namespace Dune {
 namespace Stuff {
@@ -40,6 +44,9 @@ namespace internal {
  * geometryInOutside() and indexInOutside() are well-defined and give the information from the periodically adjacent
  * entity.
  *
+ * \note PeriodicIntersection keeps a pointer to the grid view it was obtained from (and PeriodicIntersectionIterator
+ *       references to the grid view and the entity), so it must not outlive that PeriodicGridView.
+ *
  * \see PeriodicGridView
  */
 template <class RealGridViewImp>
@@ -55,13 +62,14 @@ public:
   typedef typename RealGridViewType::IntersectionIterator RealIntersectionIteratorType;
   static const size_t dimDomain = RealGridViewType::dimension;
 
-  //! \brief Constructor from real intersection
+  //! \brief Constructor from real intersection, index_in_outside is only used if periodic_pair.first is true
   PeriodicIntersection(const BaseType& real_intersection, const RealGridViewType& real_grid_view,
-                       const std::pair<bool, EntityType>& periodic_pair)
+                       const std::pair<bool, EntityType>& periodic_pair, const int index_in_outside = -1)
     : BaseType(real_intersection)
     , periodic_(periodic_pair.first)
     , outside_(periodic_pair.second)
-    , real_grid_view_(new DSC::ConstStorageProvider<RealGridViewType>(real_grid_view))
+    , index_in_outside_(index_in_outside)
+    , real_grid_view_(&real_grid_view)
   {
   }
 
@@ -94,50 +102,49 @@ public:
   int indexInOutside() const
   {
     if (periodic_) {
-      return find_intersection_in_outside().indexInInside();
+      return index_in_outside_;
     } else {
       return BaseType::indexInOutside();
     }
   } // int indexInOutside() const
 
 private:
-  // tries to find intersection in outside (works only if periodic_ == true)
+  // finds the intersection in outside (works only if periodic_ == true)
   BaseType find_intersection_in_outside() const
   {
-    const auto coords                                   = this->geometry().center();
-    RealIntersectionIteratorType outside_i_it           = real_grid_view_->access().ibegin(outside_);
-    const RealIntersectionIteratorType outside_i_it_end = real_grid_view_->access().iend(outside_);
-    // walk over outside intersections and find an intersection on the boundary that differs only in one coordinate
-    for (; outside_i_it != outside_i_it_end; ++outside_i_it) {
-      const BaseType& curr_outside_intersection = *outside_i_it;
-      if (curr_outside_intersection.boundary()) {
-        const auto curr_outside_intersection_coords = curr_outside_intersection.geometry().center();
-        size_t coord_difference_count = 0;
-        for (size_t ii = 0; ii < dimDomain; ++ii) {
-          if (Dune::Stuff::Common::FloatCmp::ne(curr_outside_intersection_coords[ii], coords[ii])) {
-            ++coord_difference_count;
-          }
-        }
-        if (coord_difference_count == size_t(1)) {
-          return *outside_i_it;
-        }
-      }
-    }
+    const auto outside_i_it_end = real_grid_view_->iend(outside_);
+    for (auto outside_i_it = real_grid_view_->ibegin(outside_); outside_i_it != outside_i_it_end; ++outside_i_it)
+      if (outside_i_it->indexInInside() == index_in_outside_)
+        return *outside_i_it;
     DUNE_THROW(Dune::InvalidStateException, "Could not find outside intersection!");
-    return *(real_grid_view_->access().ibegin(outside_));
+    return *(real_grid_view_->ibegin(outside_));
   } // ... find_intersection_in_outside() const
 
 protected:
   bool periodic_;
   EntityType outside_;
-  std::unique_ptr<DSC::ConstStorageProvider<RealGridViewType>> real_grid_view_;
+  int index_in_outside_;
+  // not owned, points to the PeriodicGridViewImp of the PeriodicGridView which created this intersection
+  const RealGridViewType* real_grid_view_;
 }; // ... class PeriodicIntersection ...
 
+//! \brief An intersection identified with an intersection on the other side of a PeriodicGridView
+template <class RealGridViewImp>
+struct PeriodicNeighbor
+{
+  typedef typename RealGridViewImp::template Codim<0>::Entity::EntitySeed EntitySeedType;
+
+  int index_in_inside;
+  int index_in_outside;
+  EntitySeedType outside;
+}; // struct PeriodicNeighbor
+
 /** \brief IntersectionIterator for PeriodicGridView
  *
  * PeriodicIntersectionIterator is derived from the IntersectionIterator of the underlying GridView and behaves exactly
  * like the underlying IntersectionIterator except that it returns a PeriodicIntersection in its operator* and
- * operator-> methods.
+ * operator-> methods. The periodic neighbors of the entity are given as a contiguous range, which is empty for all
+ * entities without periodic intersections.
  *
  * \see PeriodicGridView
  */
@@ -153,16 +160,17 @@ public:
   typedef PeriodicIntersection<RealGridViewType> Intersection;
   typedef typename RealGridViewType::template Codim<0>::Entity EntityType;
   typedef std::pair<bool, EntityType> PeriodicPairType;
+  typedef PeriodicNeighbor<RealGridViewType> PeriodicNeighborType;
   static const size_t dimDomain = RealGridViewType::dimension;
 
   PeriodicIntersectionIterator(BaseType real_intersection_iterator, const RealGridViewType& real_grid_view,
-                               const EntityType& entity,
-                               const std::map<IntersectionIndexType, PeriodicPairType>& intersection_map)
+                               const EntityType& entity, const PeriodicNeighborType* neighbors_begin,
+                               const PeriodicNeighborType* neighbors_end)
     : BaseType(real_intersection_iterator)
     , real_grid_view_(real_grid_view)
     , entity_(entity)
-    , has_boundary_intersections_(entity_.hasBoundaryIntersections())
-    , intersection_map_(intersection_map)
+    , neighbors_begin_(neighbors_begin)
+    , neighbors_end_(neighbors_end)
     , nonperiodic_pair_(std::make_pair(bool(false), EntityType(entity_)))
     , current_intersection_(create_current_intersection_safely())
   {
@@ -171,41 +179,41 @@ public:
   // methods that differ from BaseType
   const Intersection& operator*() const
   {
-    current_intersection_ = create_current_intersection();
+    current_intersection_ = create_intersection(BaseType::operator*());
     return *current_intersection_;
   }
 
   const Intersection* operator->() const
   {
-    current_intersection_ = create_current_intersection();
+    current_intersection_ = create_intersection(BaseType::operator*());
     return &(*current_intersection_);
   }
 
 private:
-  std::unique_ptr<Intersection> create_current_intersection() const
+  std::unique_ptr<Intersection> create_intersection(const RealIntersectionType& real_intersection) const
   {
-    return DSC::make_unique<Intersection>(BaseType::operator*(),
-                                          real_grid_view_,
-                                          has_boundary_intersections_
-                                              ? intersection_map_.at((BaseType::operator*()).indexInInside())
-                                              : (const PeriodicPairType&)nonperiodic_pair_);
-  } // ... create_current_intersection() const
+    if (neighbors_begin_ != neighbors_end_) {
+      const IntersectionIndexType index_in_inside = real_intersection.indexInInside();
+      for (auto neighbor = neighbors_begin_; neighbor != neighbors_end_; ++neighbor)
+        if (neighbor->index_in_inside == index_in_inside)
+          return DSC::make_unique<Intersection>(real_intersection,
+                                                real_grid_view_,
+                                                std::make_pair(true, real_grid_view_.grid().entity(neighbor->outside)),
+                                                neighbor->index_in_outside);
+    }
+    return DSC::make_unique<Intersection>(real_intersection, real_grid_view_, nonperiodic_pair_);
+  } // ... create_intersection(...)
 
   std::unique_ptr<Intersection> create_current_intersection_safely() const
   {
-    const bool is_iend                            = (*this == real_grid_view_.iend(entity_));
-    const RealIntersectionType& real_intersection = is_iend ? *real_grid_view_.ibegin(entity_) : BaseType::operator*();
-    return DSC::make_unique<Intersection>(real_intersection,
-                                          real_grid_view_,
-                                          has_boundary_intersections_
-                                              ? intersection_map_.at(real_intersection.indexInInside())
-                                              : (const PeriodicPairType&)nonperiodic_pair_);
+    const bool is_iend = (*this == real_grid_view_.iend(entity_));
+    return create_intersection(is_iend ? *real_grid_view_.ibegin(entity_) : BaseType::operator*());
   } // ... create_current_intersection_safely() const
 
   const RealGridViewType& real_grid_view_;
   const EntityType& entity_;
-  const bool has_boundary_intersections_;
-  const std::map<IntersectionIndexType, PeriodicPairType>& intersection_map_;
+  const PeriodicNeighborType* neighbors_begin_;
+  const PeriodicNeighborType* neighbors_end_;
   PeriodicPairType nonperiodic_pair_;
   mutable std::unique_ptr<Intersection> current_intersection_;
 }; // ... class PeriodicIntersectionIterator ...
@@ -282,7 +290,7 @@ public:
   typedef int IntersectionIndexType;
   typedef typename RealIntersectionType::GlobalCoordinate DomainType;
   typedef PeriodicIntersection<BaseType> Intersection;
-  typedef std::map<IntersectionIndexType, std::pair<bool, EntityType>> IntersectionMapType;
+  typedef PeriodicNeighbor<BaseType> PeriodicNeighborType;
   static const size_t dimDomain = BaseType::dimension;
 
   template <int cd>
@@ -292,7 +300,6 @@ public:
 
   PeriodicGridViewImp(const BaseType& real_grid_view, const std::bitset<dimDomain> periodic_directions)
     : BaseType(real_grid_view)
-    , empty_intersection_map_(IntersectionMapType())
     , periodic_directions_(periodic_directions)
   {
     // find lower left and upper right corner of the grid
@@ -313,86 +320,168 @@ public:
       }
     }
 
-    // walk the grid and create a map that maps each entity(index) on the boundary to a map that maps every
-    // local intersection index to a std::pair< bool, EntityType >, where the bool component of the pair
-    // indicates whether the intersection is on a periodic boundary and the second component is the periodic neighbor
-    // entity if the first component is true. If the first component is false, the Entity is not meant to be used.
-    EntityInlevelSearch<BaseType> entity_search(*this);
-    DomainType periodic_neighbor_coords;
-    IntersectionMapType intersection_neighbor_map;
+    // collect the intersections on the periodic boundaries per direction and side and match them
+    std::vector<PeriodicFace> periodic_faces[2][dimDomain];
     for (const auto& entity : DSC::entityRange(*this)) {
-      if (entity.hasBoundaryIntersections()) {
-        intersection_neighbor_map.clear();
-        const auto i_it_end = BaseType::iend(entity);
-        for (auto i_it = BaseType::ibegin(entity); i_it != i_it_end; ++i_it) {
-          const RealIntersectionType& intersection    = *i_it;
-          const IntersectionIndexType index_in_inside = intersection.indexInInside();
-          bool is_periodic = false;
-          if (intersection.boundary()) {
-            periodic_neighbor_coords   = intersection.geometry().center();
-            size_t num_boundary_coords = 0;
-            for (std::size_t ii = 0; ii < dimDomain; ++ii) {
-              if (periodic_directions_[ii]) {
-                if (Dune::Stuff::Common::FloatCmp::eq(periodic_neighbor_coords[ii], lower_left[ii])) {
-                  is_periodic = true;
-                  periodic_neighbor_coords[ii] =
-                      upper_right[ii] - 1.0 / 100.0 * (entity.geometry().center()[ii] - lower_left[ii]);
-                  ++num_boundary_coords;
-                } else if (Dune::Stuff::Common::FloatCmp::eq(periodic_neighbor_coords[ii], upper_right[ii])) {
-                  is_periodic = true;
-                  periodic_neighbor_coords[ii] =
-                      lower_left[ii] + 1.0 / 100.0 * (upper_right[ii] - entity.geometry().center()[ii]);
-                  ++num_boundary_coords;
-                }
+      if (!entity.hasBoundaryIntersections())
+        continue;
+      const auto i_it_end = BaseType::iend(entity);
+      for (auto i_it = BaseType::ibegin(entity); i_it != i_it_end; ++i_it) {
+        const RealIntersectionType& intersection = *i_it;
+        if (!intersection.boundary())
+          continue;
+        const DomainType center = intersection.geometry().center();
+        bool is_periodic = false;
+        for (std::size_t ii = 0; ii < dimDomain && !is_periodic; ++ii) {
+          if (periodic_directions_[ii]) {
+            for (size_t side = 0; side < 2 && !is_periodic; ++side) {
+              if (Dune::Stuff::Common::FloatCmp::eq(center[ii], side == 0 ? lower_left[ii] : upper_right[ii])) {
+                is_periodic = true;
+                periodic_faces[side][ii].push_back(
+                    {this->indexSet().index(entity), entity.seed(), intersection.indexInInside(), center});
               }
             }
-            assert(num_boundary_coords = 1);
-            if (is_periodic) {
-              const auto outside_ptrs = entity_search(std::vector<DomainType>(1, periodic_neighbor_coords));
-              const auto& outside_ptr = outside_ptrs.at(0);
-              if (outside_ptr == nullptr)
-                DUNE_THROW(Dune::InvalidStateException, "Could not find periodic neighbor entity");
-              intersection_neighbor_map.insert(
-                  std::make_pair(index_in_inside, std::make_pair(is_periodic, *outside_ptr)));
-            } else {
-              intersection_neighbor_map.insert(
-                  std::make_pair(index_in_inside, std::make_pair(is_periodic, EntityType(entity))));
-            }
-          } else {
-            intersection_neighbor_map.insert(
-                std::make_pair(index_in_inside, std::make_pair(bool(false), EntityType(entity))));
           }
         }
-        entity_to_intersection_map_map_.insert(
-            std::make_pair(this->indexSet().index(entity), intersection_neighbor_map));
       }
     }
+    std::vector<std::pair<EntityIndexType, PeriodicNeighborType>> neighbors;
+    for (std::size_t ii = 0; ii < dimDomain; ++ii)
+      match_periodic_faces(periodic_faces[0][ii], periodic_faces[1][ii], ii, lower_left, upper_right, neighbors);
+
+    // store the periodic neighbors of all entities contiguously, ordered by entity index (CSR format), such that the
+    // neighbors of the entity with index ii are [neighbor_offsets_[ii], neighbor_offsets_[ii + 1])
+    std::sort(neighbors.begin(),
+              neighbors.end(),
+              [](const std::pair<EntityIndexType, PeriodicNeighborType>& left,
+                 const std::pair<EntityIndexType, PeriodicNeighborType>& right) { return left.first < right.first; });
+    neighbor_offsets_.assign(this->indexSet().size(0) + 1, 0);
+    neighbors_.reserve(neighbors.size());
+    for (const auto& neighbor : neighbors) {
+      ++neighbor_offsets_[neighbor.first + 1];
+      neighbors_.push_back(neighbor.second);
+    }
+    std::partial_sum(neighbor_offsets_.begin(), neighbor_offsets_.end(), neighbor_offsets_.begin());
   } // constructor PeriodicGridViewImp(...)
 
   IntersectionIterator ibegin(const typename Codim<0>::Entity& entity) const
   {
-    return IntersectionIterator(BaseType::ibegin(entity),
-                                *this,
-                                entity,
-                                entity.hasBoundaryIntersections()
-                                    ? entity_to_intersection_map_map_.at(this->indexSet().index(entity))
-                                    : (const IntersectionMapType&)empty_intersection_map_);
-
+    const auto neighbors = periodic_neighbors(entity);
+    return IntersectionIterator(BaseType::ibegin(entity), *this, entity, neighbors.first, neighbors.second);
   } // ... ibegin(...)
 
   IntersectionIterator iend(const typename Codim<0>::Entity& entity) const
   {
-    return IntersectionIterator(BaseType::iend(entity),
-                                *this,
-                                entity,
-                                entity.hasBoundaryIntersections()
-                                    ? entity_to_intersection_map_map_.at(this->indexSet().index(entity))
-                                    : (const IntersectionMapType&)empty_intersection_map_);
+    const auto neighbors = periodic_neighbors(entity);
+    return IntersectionIterator(BaseType::iend(entity), *this, entity, neighbors.first, neighbors.second);
   } // ... iend(...)
 
 private:
-  std::map<EntityIndexType, IntersectionMapType> entity_to_intersection_map_map_;
-  const IntersectionMapType empty_intersection_map_;
+  struct PeriodicFace
+  {
+    EntityIndexType index;
+    typename PeriodicNeighborType::EntitySeedType seed;
+    IntersectionIndexType index_in_inside;
+    DomainType center;
+  };
+
+  typedef std::array<long long, dimDomain> FaceKeyType;
+
+  struct FaceKeyHash
+  {
+    size_t operator()(const FaceKeyType& key) const
+    {
+      size_t ret = 0;
+      for (const auto& entry : key)
+        ret = 31 * ret + std::hash<long long>()(entry);
+      return ret;
+    }
+  };
+
+  /**
+   * \brief Identifies each face on the lower boundary in direction dd with the face on the upper boundary which has the
+   *        same center in all other directions.
+   *
+   *        The centers of the upper faces are projected along dd, quantized and hashed, so that each lower face only
+   *        has to be compared to the upper faces in the neighboring buckets.
+   */
+  static void match_periodic_faces(const std::vector<PeriodicFace>& lower_faces,
+                                   const std::vector<PeriodicFace>& upper_faces, const size_t dd,
+                                   const DomainType& lower_left, const DomainType& upper_right,
+                                   std::vector<std::pair<EntityIndexType, PeriodicNeighborType>>& neighbors)
+  {
+    if (lower_faces.size() != upper_faces.size())
+      DUNE_THROW(Dune::InvalidStateException,
+                 "There are " << lower_faces.size() << " intersections on the lower and " << upper_faces.size()
+                              << " on the upper boundary in direction " << dd << ", they cannot be identified!");
+    if (lower_faces.empty())
+      return;
+    // faces closer than this end up in the same bucket, which is correct but slower
+    DomainType bucket_width = upper_right;
+    bucket_width -= lower_left;
+    bucket_width *= 1e-4;
+    const auto key = [&](const DomainType& center) {
+      FaceKeyType ret;
+      for (size_t ii = 0; ii < dimDomain; ++ii)
+        ret[ii] = (ii == dd) ? 0 : (long long)(std::floor((center[ii] - lower_left[ii]) / bucket_width[ii]));
+      return ret;
+    };
+    std::unordered_multimap<FaceKeyType, size_t, FaceKeyHash> buckets(upper_faces.size());
+    for (size_t ff = 0; ff < upper_faces.size(); ++ff)
+      buckets.emplace(key(upper_faces[ff].center), ff);
+    std::vector<bool> matched(upper_faces.size(), false);
+    size_t num_neighbors = 1;
+    for (size_t ii = 0; ii < dimDomain; ++ii)
+      num_neighbors *= 3;
+    for (const auto& lower_face : lower_faces) {
+      const FaceKeyType lower_key = key(lower_face.center);
+      const PeriodicFace* partner = nullptr;
+      // visit all neighboring buckets (but not along dd), since equal centers may have been quantized differently
+      for (size_t nn = 0; nn < num_neighbors && partner == nullptr; ++nn) {
+        FaceKeyType neighbor_key = lower_key;
+        bool along_dd = false;
+        for (size_t ii = 0, code = nn; ii < dimDomain; ++ii, code /= 3) {
+          neighbor_key[ii] += (long long)(code % 3) - 1;
+          along_dd = along_dd || (ii == dd && code % 3 != 1);
+        }
+        if (along_dd)
+          continue;
+        const auto range = buckets.equal_range(neighbor_key);
+        for (auto it = range.first; it != range.second && partner == nullptr; ++it) {
+          const auto& upper_face = upper_faces[it->second];
+          bool same_center = true;
+          for (size_t ii = 0; ii < dimDomain; ++ii)
+            if (ii != dd && Dune::Stuff::Common::FloatCmp::ne(lower_face.center[ii], upper_face.center[ii]))
+              same_center = false;
+          if (same_center && !matched[it->second]) {
+            matched[it->second] = true;
+            partner = &upper_face;
+          }
+        }
+      }
+      if (partner == nullptr)
+        DUNE_THROW(Dune::InvalidStateException, "Could not find periodic neighbor entity");
+      neighbors.emplace_back(
+          lower_face.index,
+          PeriodicNeighborType{lower_face.index_in_inside, partner->index_in_inside, partner->seed});
+      neighbors.emplace_back(
+          partner->index,
+          PeriodicNeighborType{partner->index_in_inside, lower_face.index_in_inside, lower_face.seed});
+    }
+  } // ... match_periodic_faces(...)
+
+  std::pair<const PeriodicNeighborType*, const PeriodicNeighborType*>
+      periodic_neighbors(const EntityType& entity) const
+  {
+    if (neighbors_.empty() || !entity.hasBoundaryIntersections())
+      return std::make_pair(nullptr, nullptr);
+    const auto index = this->indexSet().index(entity);
+    return std::make_pair(neighbors_.data() + neighbor_offsets_[index],
+                          neighbors_.data() + neighbor_offsets_[index + 1]);
+  } // ... periodic_neighbors(...)
+
+  std::vector<size_t> neighbor_offsets_;
+  std::vector<PeriodicNeighborType> neighbors_;
   const std::bitset<dimDomain> periodic_directions_;
 }; // ... class PeriodicGridViewImp ...
 
@@ -406,23 +495,19 @@ private:
  * operator*. The PeriodicIntersection again behaves like an Intersection of the underlying GridView, but may return
  * neighbor() == true and an outside() entity even if it is on the boundary. The outside() entity is the entity
  * adjacent to the intersection if it is identified with the intersection on the other side of the grid.
- * In the constructor, PeriodicGridViewImp will build a map mapping boundary entity indices to a map mapping local
- * intersection indices to a std::pair containing the information whether this intersection shall be periodic and the
- * outside entity. This may take quite long as finding the outside entity requires a grid walk for each periodic
- * intersection.
+ * In the constructor, PeriodicGridViewImp stores the periodic neighbors (local intersection index, the seed of the
+ * outside entity and the local intersection index in the outside entity) of all entities in flat arrays indexed by
+ * entity index, so iterating over the intersections costs hardly more than on the underlying GridView. The outside
+ * entities are found by matching the centers of the intersections on opposite sides of the grid via a hash table, so
+ * the construction takes time linear in the number of boundary intersections.
  * By default, all coordinate directions will be made periodic. By supplying a std::bitset< dimension > you can decide
  * for each direction whether it should be periodic (1 means periodic, 0 means 'behave like underlying GridView in that
  * direction').
 
    \note
-      -  Currently, PeriodicGridView will only work with GridViews on the unit hypercube
-      -  Only cube and regular simplex grids have been tested so far. Other grids may not work properly. This is due to
-      the heuristics for finding the periodic neighbor entity: Given an intersection on the boundary that shall be
-      periodic, the coordinates intersection.geometry().center() are moved to the other side of the grid and then
-      supplied to Dune::Stuff::Grid::EntityInLevelSearch. As the coordinates are on the boundary of the wanted entity,
-      this search will fail for some grids. Thus, the coordinates are moved a little to the inside of the grid before
-      searching for the entity. The moved coordinates will be inside the wanted entity for cube and usual simplex grids
-      but this is not guaranteed for arbitrary grids.
+      -  Currently, PeriodicGridView will only work with GridViews on axis-parallel hyperrectangles
+      -  The intersections on opposite periodic boundaries have to match, i.e. for each intersection there has to be
+      an intersection on the other side of the grid whose center only differs in the periodic direction.
  */
 template <class RealGridViewImp>
 class PeriodicGridView : Dune::Stuff::Common::ConstStorageProvider<internal::PeriodicGridViewImp<RealGridViewImp>>,
@@ -15,6 +15,7 @@
 #include <dune/stuff/common/configuration.hh>
 
 #include "provider/interface.hh"
+#include "provider/checkpoint.hh"
 #include "provider/cube.hh"
 
 namespace Dune {
@@ -42,7 +43,7 @@ public:
   static std::vector<std::string> available()
   {
     namespace Providers = Stuff::Grid::Providers;
-    return {Providers::Cube<GridType>::static_id()};
+    return {Providers::Cube<GridType>::static_id(), Providers::Checkpoint<GridType>::static_id()};
   } // ... available()
 
   static Common::Configuration default_config(const std::string type, const std::string subname = "")
@@ -50,6 +51,8 @@ public:
     namespace Providers = Stuff::Grid::Providers;
     if (type == Providers::Cube<GridType>::static_id())
       return Providers::Cube<GridType>::default_config(subname);
+    else if (type == Providers::Checkpoint<GridType>::static_id())
+      return Providers::Checkpoint<GridType>::default_config(subname);
     else
       DUNE_THROW(Exceptions::wrong_input_given,
                  "'" << type << "' is not a valid " << InterfaceType::static_id() << "!");
@@ -66,6 +69,8 @@ public:
     namespace Providers = Stuff::Grid::Providers;
     if (type == Providers::Cube<GridType>::static_id())
       return call_create<Providers::Cube<GridType>>(config);
+    else if (type == Providers::Checkpoint<GridType>::static_id())
+      return call_create<Providers::Checkpoint<GridType>>(config);
     else
       DUNE_THROW(Exceptions::wrong_input_given,
                  "'" << type << "' is not a valid " << InterfaceType::static_id() << "!");
@@ -0,0 +1,127 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_STUFF_GRID_PROVIDER_CHECKPOINT_HH
+#define DUNE_STUFF_GRID_PROVIDER_CHECKPOINT_HH
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <dune/common/exceptions.hh>
+
+#if HAVE_DUNE_GRID
+#include <dune/grid/common/backuprestore.hh>
+#endif
+
+#include <dune/stuff/common/configuration.hh>
+#include <dune/stuff/common/memory.hh>
+
+#include "interface.hh"
+
+namespace Dune {
+namespace Stuff {
+namespace Grid {
+namespace Providers {
+
+#if HAVE_DUNE_GRID
+
+/**
+ * \brief Restores a grid from a checkpoint written by ConstProviderInterface::checkpoint().
+ *
+ *        The grid is read directly, without recreating, refining or balancing it. Thus restarting a run on a large
+ *        refined grid only costs the I/O.
+ */
+template <class GridImp>
+class Checkpoint : public ProviderInterface<GridImp>
+{
+  typedef ProviderInterface<GridImp> BaseType;
+  typedef Checkpoint<GridImp> ThisType;
+
+public:
+  using typename BaseType::GridType;
+
+  static const std::string static_id() { return BaseType::static_id() + ".checkpoint"; }
+
+  static Common::Configuration default_config(const std::string sub_name = "")
+  {
+    Common::Configuration config("filename", "checkpoint");
+    if (sub_name.empty())
+      return config;
+    else {
+      Common::Configuration tmp;
+      tmp.add(config, sub_name);
+      return tmp;
+    }
+  } // ... default_config(...)
+
+  static std::unique_ptr<ThisType> create(const Common::Configuration config = default_config(),
+                                          const std::string sub_name = static_id())
+  {
+    const Common::Configuration cfg         = config.has_sub(sub_name) ? config.sub(sub_name) : config;
+    const Common::Configuration default_cfg = default_config();
+    return Common::make_unique<ThisType>(cfg.get("filename", default_cfg.get<std::string>("filename")));
+  }
+
+  explicit Checkpoint(const std::string filename)
+    : grid_(restore(filename))
+  {
+  }
+
+  virtual ~Checkpoint() = default;
+
+  virtual const GridType& grid() const override final { return *grid_; }
+
+  virtual GridType& grid() override final { return *grid_; }
+
+  const std::shared_ptr<const GridType> grid_ptr() const { return grid_; }
+
+  std::shared_ptr<GridType> grid_ptr() { return grid_; }
+
+private:
+  /**
+   * \note The file of this rank is chosen by the default communicator of GridType, on which the grid is restored and
+   *       which thus coincides with grid().comm() used by ConstProviderInterface::checkpoint().
+   */
+  static std::shared_ptr<GridType> restore(const std::string& filename)
+  {
+    const typename GridType::CollectiveCommunication comm;
+    const std::string rank_filename = internal::checkpoint_filename(filename, comm.rank(), comm.size());
+    if (!std::ifstream(rank_filename))
+      DUNE_THROW(IOError, "could not open checkpoint '" << rank_filename << "'!");
+    std::shared_ptr<GridType> grid(BackupRestoreFacility<GridType>::restore(rank_filename));
+    if (!grid)
+      DUNE_THROW(IOError, "could not restore a grid from '" << rank_filename << "'!");
+    if (grid->comm().rank() != comm.rank() || grid->comm().size() != comm.size())
+      DUNE_THROW(InvalidStateException,
+                 "the grid restored from '" << rank_filename << "' lives on rank " << grid->comm().rank() << " of "
+                                            << grid->comm().size()
+                                            << ", not on rank "
+                                            << comm.rank()
+                                            << " of "
+                                            << comm.size()
+                                            << "!");
+    return grid;
+  } // ... restore(...)
+
+  std::shared_ptr<GridType> grid_;
+}; // class Checkpoint
+
+#else // HAVE_DUNE_GRID
+
+template <class GridImp>
+class Checkpoint
+{
+  static_assert(AlwaysFalse<GridImp>::value, "You are missing dune-grid!");
+};
+
+#endif // HAVE_DUNE_GRID
+
+} // namespace Providers
+} // namespace Grid
+} // namespace Stuff
+} // namespace Dune
+
+#endif // DUNE_STUFF_GRID_PROVIDER_CHECKPOINT_HH
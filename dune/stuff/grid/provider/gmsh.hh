@@ -13,6 +13,7 @@
 #include <memory>
 #include <type_traits>
 
+#include <dune/grid/common/gridfactory.hh>
 #include <dune/grid/utility/structuredgridfactory.hh>
 #include <dune/grid/alugrid.hh>
 #include <dune/grid/sgrid.hh>
@@ -30,6 +31,9 @@ namespace Providers {
 
 /**
  * \brief   Gmsh grid provider
+ *
+ *          By default, each rank reads the whole file and builds the whole grid. If distribute is true, only rank 0
+ *          parses the file and the grid is distributed by loadBalance(), \sa create_grid().
  */
 template <class GridImp>
 class Gmsh : public Grid::ProviderInterface<GridImp>
@@ -53,6 +57,7 @@ public:
         || std::is_same<ALUGrid<2, 2, simplex, nonconforming>, GridType>::value)
       filename = "gmsh_2d_simplices.msh";
     Common::Configuration config("filename", filename);
+    config["distribute"] = "false";
     if (sub_name.empty())
       return config;
     else {
@@ -67,10 +72,14 @@ public:
   {
     const Common::Configuration cfg         = config.has_sub(sub_name) ? config.sub(sub_name) : config;
     const Common::Configuration default_cfg = default_config();
-    return Common::make_unique<ThisType>(cfg.get("filename", default_cfg.get<std::string>("filename")));
+    return Common::make_unique<ThisType>(cfg.get("filename", default_cfg.get<std::string>("filename")),
+                                         cfg.get("distribute", default_cfg.get<bool>("distribute")));
   }
 
-  Gmsh(const std::string filename) { grid_ = std::shared_ptr<GridType>(GmshReader<GridType>::read(filename)); }
+  Gmsh(const std::string filename, const bool distribute = false)
+    : grid_(create_grid(filename, distribute))
+  {
+  }
 
   Gmsh(ThisType&& source) = default;
   Gmsh(const ThisType& other) = default;
@@ -89,6 +98,28 @@ public:
   std::shared_ptr<GridType> grid_ptr() { return grid_; }
 
 private:
+  /**
+   * \brief Reads the grid on all ranks or, if distribute is true, only on rank 0.
+   *
+   *        In the latter case all other ranks insert nothing into their factory and the macro grid is distributed by
+   *        the partitioner of the grid implementation in loadBalance(). Thus the file is parsed only once and no rank
+   *        but rank 0 ever holds the whole grid. This requires a grid with a parallel factory, e.g. ALUGrid or UGGrid.
+   * \note  The ranks are those of the default communicator of GridType, which the factory uses as well. For grids
+   *        without parallel support this communicator only contains the calling process, so each rank reads the file.
+   */
+  static std::shared_ptr<GridType> create_grid(const std::string& filename, const bool distribute)
+  {
+    if (!distribute)
+      return std::shared_ptr<GridType>(GmshReader<GridType>::read(filename));
+    GridFactory<GridType> factory;
+    const typename GridType::CollectiveCommunication comm;
+    if (comm.rank() == 0)
+      GmshReader<GridType>::read(factory, filename);
+    std::shared_ptr<GridType> grid(factory.createGrid());
+    grid->loadBalance();
+    return grid;
+  } // ... create_grid(...)
+
   std::shared_ptr<GridType> grid_;
 }; // class Gmsh
 
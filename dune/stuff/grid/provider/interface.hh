@@ -9,10 +9,12 @@
 #define DUNE_STUFF_GRID_PROVIDER_INTERFACE_HH
 
 #include <memory>
+#include <string>
 
 #include <dune/common/fvector.hh>
 
 #if HAVE_DUNE_GRID
+#include <dune/grid/common/backuprestore.hh>
 #include <dune/grid/io/file/vtk/vtkwriter.hh>
 #endif
 
@@ -28,6 +30,16 @@ namespace Grid {
 
 #if HAVE_DUNE_GRID
 
+namespace internal {
+
+//! each rank of a parallel run writes (and restores) its own checkpoint file
+inline std::string checkpoint_filename(const std::string& filename, const int rank, const int size)
+{
+  return size > 1 ? filename + ".rank" + std::to_string(rank) : filename;
+}
+
+} // namespace internal
+
 template <class GridImp>
 class ConstProviderInterface
 {
@@ -130,6 +142,20 @@ public:
     visualize_with_boundary(boundary_info_cfg, filename);
   }
 
+  /**
+   * \brief Writes the grid to a checkpoint, from which Providers::Checkpoint restores it.
+   *
+   *        The grid is written by the Dune::BackupRestoreFacility of the grid implementation. Thus the checkpoint
+   *        contains whatever this implementation stores (e.g. the whole hierarchy, the partition and the boundary ids
+   *        for ALUGrid) and grids without such a facility throw NotImplemented. A checkpoint written by n ranks has to
+   *        be restored by n ranks.
+   */
+  virtual void checkpoint(const std::string filename) const
+  {
+    const auto& comm = grid().comm();
+    BackupRestoreFacility<GridType>::backup(grid(), internal::checkpoint_filename(filename, comm.rank(), comm.size()));
+  }
+
 private:
   virtual void visualize_plain(const std::string filename) const
   {
@@ -8,9 +8,17 @@
 
 #if HAVE_DUNE_GRID
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
 #include <vector>
 
-#include <boost/range/iterator_range.hpp>
+#if HAVE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
 
 #if HAVE_DUNE_GEOMETRY
 #include <dune/geometry/referenceelements.hh>
@@ -20,8 +28,11 @@
 #include <dune/grid/common/gridview.hh>
 
 #include <dune/stuff/aliases.hh>
+#include <dune/stuff/common/bounding-box-tree.hh>
+#include <dune/stuff/common/exceptions.hh>
 #include <dune/stuff/common/ranges.hh>
 #include <dune/stuff/common/memory.hh>
+#include <dune/stuff/common/unused.hh>
 #include <dune/stuff/grid/entity.hh>
 
 namespace Dune {
@@ -40,6 +51,16 @@ public:
   typedef typename EntityType::Geometry::LocalCoordinate LocalCoordinateType;
   typedef typename EntityType::Geometry::GlobalCoordinate GlobalCoordinateType;
   typedef std::vector<std::unique_ptr<EntityType>> EntityVectorType;
+  typedef typename EntityType::EntitySeed EntitySeedType;
+
+  //! where a point was found: the seed of the containing entity and the point in its reference coordinates
+  struct LocationType
+  {
+    bool found;
+    EntitySeedType seed;
+    LocalCoordinateType local;
+  };
+  typedef std::vector<LocationType> LocationVectorType;
 }; // class EntitySearchBase
 
 template <class GridViewType>
@@ -107,54 +128,429 @@ private:
   IteratorType it_last_;
 }; // class EntityInlevelSearch
 
+namespace internal {
+
+/**
+ * \brief Batched queries for searches which can locate a single point.
+ *
+ *        Derived has to provide grid_view() and a thread safe bool locate(point, location), which returns false if the
+ *        point lies outside of the grid view.
+ */
+template <class Derived, class GridViewType>
+class BatchedEntitySearchBase : public EntitySearchBase<GridViewType>
+{
+  typedef EntitySearchBase<GridViewType> BaseType;
+
+public:
+  using typename BaseType::EntityType;
+  using typename BaseType::EntityVectorType;
+  using typename BaseType::LocationType;
+  using typename BaseType::LocationVectorType;
+
+  /**
+   * \brief Locates all points, in parallel if use_tbb is true.
+   * \note  The points are accessed by index, so PointContainerType has to provide size() and operator[].
+   */
+  template <class PointContainerType>
+  LocationVectorType locate(const PointContainerType& points, const bool use_tbb = false) const
+  {
+    LocationVectorType ret(points.size());
+#if HAVE_TBB
+    if (use_tbb) {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, ret.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t ii = range.begin(); ii != range.end(); ++ii)
+          derived().locate(points[ii], ret[ii]);
+      });
+      return ret;
+    }
+#else
+    const auto DSC_UNUSED(no_warning_for_use_tbb) = use_tbb;
+#endif
+    for (size_t ii = 0; ii < ret.size(); ++ii)
+      derived().locate(points[ii], ret[ii]);
+    return ret;
+  } // ... locate(...)
+
+  //! same interface as EntityInlevelSearch, contains nullptr for each point outside of the grid view
+  template <class PointContainerType>
+  EntityVectorType operator()(const PointContainerType& points) const
+  {
+    EntityVectorType ret;
+    ret.reserve(points.size());
+    LocationType location;
+    for (const auto& point : points) {
+      if (derived().locate(point, location))
+        ret.emplace_back(DSC::make_unique<EntityType>(derived().grid_view().grid().entity(location.seed)));
+      else
+        ret.emplace_back(nullptr);
+    }
+    return ret;
+  } // ... operator()(...)
+
+private:
+  const Derived& derived() const { return static_cast<const Derived&>(*this); }
+}; // class BatchedEntitySearchBase
+
+} // namespace internal
+
+/**
+ * \brief Locates points in the codim 0 entities of a grid view using a bounding volume hierarchy.
+ *
+ *        The bounding boxes of all entities are computed once in the constructor and stored in a
+ *        Common::BoundingBoxTree, so that each query only inverts the geometries of the (few) entities whose bounding
+ *        box contains the point, i.e. costs O(log n) instead of the O(n) of EntityInlevelSearch. Queries do not modify
+ *        the search, so the same search may be used for many batches of points and from several threads.
+ */
+template <class GridViewType>
+class EntityBoundingBoxSearch
+    : public internal::BatchedEntitySearchBase<EntityBoundingBoxSearch<GridViewType>, GridViewType>
+{
+  typedef internal::BatchedEntitySearchBase<EntityBoundingBoxSearch<GridViewType>, GridViewType> BaseType;
+
+public:
+  using typename BaseType::GlobalCoordinateType;
+  using typename BaseType::EntitySeedType;
+  using typename BaseType::LocationType;
+  typedef typename GridViewType::ctype DomainFieldType;
+  static const size_t dimWorld = GlobalCoordinateType::dimension;
+  typedef Common::BoundingBoxTree<DomainFieldType, dimWorld> TreeType;
+
+  explicit EntityBoundingBoxSearch(const GridViewType& grid_view)
+    : grid_view_(grid_view)
+  {
+    std::vector<typename TreeType::BoxType> boxes;
+    boxes.reserve(grid_view_.size(0));
+    seeds_.reserve(grid_view_.size(0));
+    for (const auto& entity : DSC::entityRange(grid_view_)) {
+      const auto geometry = entity.geometry();
+      typename TreeType::BoxType box;
+      for (int cc = 0; cc < geometry.corners(); ++cc)
+        box.extend(geometry.corner(cc));
+      // checkInside() allows for a small tolerance, so should we
+      for (size_t dd = 0; dd < dimWorld; ++dd) {
+        const DomainFieldType eps = 1e-8 * (box.upper_right[dd] - box.lower_left[dd]);
+        box.lower_left[dd] -= eps;
+        box.upper_right[dd] += eps;
+      }
+      boxes.push_back(box);
+      seeds_.push_back(entity.seed());
+    }
+    tree_.build(boxes);
+  } // EntityBoundingBoxSearch(...)
+
+  const GridViewType& grid_view() const { return grid_view_; }
+
+  using BaseType::locate;
+
+  //! locates a single point, returns false if the point lies outside of the grid view
+  bool locate(const GlobalCoordinateType& point, LocationType& ret) const
+  {
+    ret.found = false;
+    tree_.for_each_containing(point, [&](const size_t ii) {
+      const auto entity   = grid_view_.grid().entity(seeds_[ii]);
+      const auto geometry = entity.geometry();
+      const auto local    = geometry.local(point);
+      if (DSG::reference_element(geometry).checkInside(local)) {
+        ret.found = true;
+        ret.seed  = seeds_[ii];
+        ret.local = local;
+      }
+      return !ret.found;
+    });
+    return ret.found;
+  } // ... locate(...)
+
+private:
+  const GridViewType grid_view_;
+  std::vector<EntitySeedType> seeds_;
+  TreeType tree_;
+}; // class EntityBoundingBoxSearch
+
+/**
+ * \brief Locates points in axis aligned structured grids in O(1), e.g. grids created by Providers::Cube or
+ *        StructuredGridFactory.
+ *
+ *        The cell containing a point is computed arithmetically from the lower left corner and the width of the
+ *        cells, its seed is then looked up in a table built once in the constructor. The constructor checks that the
+ *        grid view actually consists of equally sized, axis aligned cubes covering a box and throws otherwise.
+ */
+template <class GridViewType>
+class EntityStructuredSearch
+    : public internal::BatchedEntitySearchBase<EntityStructuredSearch<GridViewType>, GridViewType>
+{
+  typedef internal::BatchedEntitySearchBase<EntityStructuredSearch<GridViewType>, GridViewType> BaseType;
+
+public:
+  using typename BaseType::GlobalCoordinateType;
+  using typename BaseType::EntitySeedType;
+  using typename BaseType::LocationType;
+  typedef typename GridViewType::ctype DomainFieldType;
+  static const size_t dimDomain = GridViewType::dimension;
+  static_assert(dimDomain == GlobalCoordinateType::dimension, "Only available for grids of full dimension!");
+
+  explicit EntityStructuredSearch(const GridViewType& grid_view)
+    : grid_view_(grid_view)
+    , lower_left_(std::numeric_limits<DomainFieldType>::max())
+    , upper_right_(std::numeric_limits<DomainFieldType>::lowest())
+  {
+    if (grid_view_.size(0) == 0)
+      DUNE_THROW(Exceptions::wrong_input_given, "The grid view must not be empty!");
+    for (const auto& entity : DSC::entityRange(grid_view_)) {
+      const auto geometry = entity.geometry();
+      if (!geometry.type().isCube())
+        DUNE_THROW(Exceptions::wrong_input_given, "The grid view does not consist of cubes!");
+      for (size_t dd = 0; dd < dimDomain; ++dd) {
+        lower_left_[dd]  = std::min(lower_left_[dd], geometry.corner(0)[dd]);
+        upper_right_[dd] = std::max(upper_right_[dd], geometry.corner((1 << dimDomain) - 1)[dd]);
+      }
+    }
+    const auto first_geometry = grid_view_.template begin<0>()->geometry();
+    size_t num_cells = 1;
+    for (size_t dd = 0; dd < dimDomain; ++dd) {
+      const DomainFieldType extent = upper_right_[dd] - lower_left_[dd];
+      const DomainFieldType width  = first_geometry.corner(1 << dd)[dd] - first_geometry.corner(0)[dd];
+      if (!(width > 0))
+        DUNE_THROW(Exceptions::wrong_input_given, "The grid view does not consist of axis aligned cubes!");
+      num_elements_[dd]            = std::max(size_t(std::round(extent / width)), size_t(1));
+      cell_width_[dd]              = extent / num_elements_[dd];
+      num_cells *= num_elements_[dd];
+    }
+    if (num_cells != size_t(grid_view_.size(0)))
+      DUNE_THROW(Exceptions::wrong_input_given,
+                 "The grid view is not structured (has " << grid_view_.size(0) << " elements, expected " << num_cells
+                                                         << ")!");
+    seeds_.resize(num_cells);
+    std::vector<bool> seen(num_cells, false);
+    for (const auto& entity : DSC::entityRange(grid_view_)) {
+      const auto geometry = entity.geometry();
+      const auto cell     = cell_index(geometry.center());
+      if (seen[cell] || !is_axis_aligned_cell(geometry, cell))
+        DUNE_THROW(Exceptions::wrong_input_given,
+                   "The grid view does not consist of equally sized axis aligned cubes!");
+      seen[cell]   = true;
+      seeds_[cell] = entity.seed();
+    }
+  } // EntityStructuredSearch(...)
+
+  const GridViewType& grid_view() const { return grid_view_; }
+
+  const GlobalCoordinateType& lower_left() const { return lower_left_; }
+
+  const GlobalCoordinateType& upper_right() const { return upper_right_; }
+
+  const std::array<size_t, dimDomain>& num_elements() const { return num_elements_; }
+
+  using BaseType::locate;
+
+  //! locates a single point, returns false if the point lies outside of the grid view
+  bool locate(const GlobalCoordinateType& point, LocationType& ret) const
+  {
+    size_t cell   = 0;
+    size_t stride = 1;
+    for (size_t dd = 0; dd < dimDomain; ++dd) {
+      const DomainFieldType xx = (point[dd] - lower_left_[dd]) / cell_width_[dd];
+      if (xx < -tolerance || xx > num_elements_[dd] + tolerance)
+        return (ret.found = false);
+      const size_t ii = std::min(size_t(std::max(xx, DomainFieldType(0))), num_elements_[dd] - 1);
+      ret.local[dd] = xx - DomainFieldType(ii);
+      cell += ii * stride;
+      stride *= num_elements_[dd];
+    }
+    ret.seed = seeds_[cell];
+    return (ret.found = true);
+  } // ... locate(...)
+
+private:
+  static constexpr DomainFieldType tolerance = 1e-8;
+
+  size_t cell_index(const GlobalCoordinateType& point) const
+  {
+    size_t cell   = 0;
+    size_t stride = 1;
+    for (size_t dd = 0; dd < dimDomain; ++dd) {
+      const DomainFieldType xx = (point[dd] - lower_left_[dd]) / cell_width_[dd];
+      cell += std::min(size_t(std::max(xx, DomainFieldType(0))), num_elements_[dd] - 1) * stride;
+      stride *= num_elements_[dd];
+    }
+    return cell;
+  } // ... cell_index(...)
+
+  //! corner(0) is the lower left corner of the cell and the local coordinate axes are the global ones
+  template <class GeometryType>
+  bool is_axis_aligned_cell(const GeometryType& geometry, size_t cell) const
+  {
+    if (geometry.corners() != (1 << dimDomain))
+      return false;
+    for (size_t dd = 0; dd < dimDomain; ++dd) {
+      const DomainFieldType expected = lower_left_[dd] + (cell % num_elements_[dd]) * cell_width_[dd];
+      cell /= num_elements_[dd];
+      if (std::abs(geometry.corner(0)[dd] - expected) > tolerance * cell_width_[dd])
+        return false;
+      for (size_t cc = 0; cc < dimDomain; ++cc) {
+        const DomainFieldType difference = geometry.corner(1 << cc)[dd] - geometry.corner(0)[dd];
+        if (std::abs(difference - (cc == dd ? cell_width_[dd] : DomainFieldType(0))) > tolerance * cell_width_[dd])
+          return false;
+      }
+    }
+    return true;
+  } // ... is_axis_aligned_cell(...)
+
+  const GridViewType grid_view_;
+  GlobalCoordinateType lower_left_;
+  GlobalCoordinateType upper_right_;
+  std::array<size_t, dimDomain> num_elements_;
+  GlobalCoordinateType cell_width_;
+  std::vector<EntitySeedType> seeds_;
+}; // class EntityStructuredSearch
+
+/**
+ * \brief Locates points by descending the grid hierarchy from a coarse level to the entities of a grid view.
+ *
+ *        All points of a batch are first located in the entities of the start level by an EntityBoundingBoxSearch,
+ *        which is built once in the constructor, and grouped by these roots. They are then recursively sorted into the
+ *        children of each entity (like the traversal of a tree code), until they reach an entity of the grid view or a
+ *        leaf. The points are only permuted within a single index vector per batch, so the descent does not allocate
+ *        per point or level. The subtrees of the entities of the start level are independent and may thus be
+ *        processed in parallel.
+ */
 template <class GridViewType>
 class EntityHierarchicSearch : public EntitySearchBase<GridViewType>
 {
   typedef EntitySearchBase<GridViewType> BaseType;
-
-  const GridViewType gridview_;
-  const int start_level_;
+  typedef typename GridViewType::Grid::LevelGridView LevelGridViewType;
 
 public:
-  EntityHierarchicSearch(const GridViewType& gridview) : gridview_(gridview), start_level_(0) {}
+  using typename BaseType::EntityType;
+  using typename BaseType::EntityVectorType;
+  using typename BaseType::EntitySeedType;
+  using typename BaseType::LocationVectorType;
 
-  typedef typename BaseType::EntityVectorType EntityVectorType;
+  explicit EntityHierarchicSearch(const GridViewType& grid_view, const int start_level = 0)
+    : grid_view_(grid_view)
+    , start_level_(std::min(grid_view_.grid().maxLevel(), start_level))
+    , root_search_(grid_view_.grid().levelGridView(start_level_))
+  {
+  }
+
+  const GridViewType& grid_view() const { return grid_view_; }
 
+  /**
+   * \brief Locates all points, the subtrees are processed in parallel if use_tbb is true.
+   * \note  The points are accessed by index, so PointContainerType has to provide size() and operator[].
+   */
+  template <class PointContainerType>
+  LocationVectorType locate(const PointContainerType& points, const bool use_tbb = false) const
+  {
+    LocationVectorType ret(points.size());
+    for (auto& location : ret)
+      location.found = false;
+    // the entities of the start level containing points are the roots of the subtrees, the points of each root are
+    // stored contiguously in order (points outside of the grid view have no root and are left out)
+    const auto roots           = root_search_.locate(points, use_tbb);
+    const auto& root_index_set = root_search_.grid_view().indexSet();
+    const size_t num_roots     = root_index_set.size(0);
+    std::vector<size_t> root_indices(points.size(), num_roots);
+    std::vector<EntitySeedType> root_seeds(num_roots);
+    std::vector<size_t> offsets(num_roots + 1, 0);
+    for (size_t ii = 0; ii < points.size(); ++ii) {
+      if (!roots[ii].found)
+        continue;
+      root_indices[ii]             = root_index_set.index(grid_view_.grid().entity(roots[ii].seed));
+      root_seeds[root_indices[ii]] = roots[ii].seed;
+      ++offsets[root_indices[ii] + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<size_t> order(offsets.back());
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (size_t ii = 0; ii < points.size(); ++ii)
+      if (root_indices[ii] < num_roots)
+        order[next[root_indices[ii]]++] = ii;
+    std::vector<Subtree> subtrees;
+    for (size_t rr = 0; rr < num_roots; ++rr)
+      if (offsets[rr + 1] > offsets[rr])
+        subtrees.push_back({root_seeds[rr], offsets[rr], offsets[rr + 1]});
+    const auto process = [&](const Subtree& subtree) {
+      descend(grid_view_.grid().entity(subtree.seed), points, order, subtree.begin, subtree.end, ret);
+    };
+#if HAVE_TBB
+    if (use_tbb) {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, subtrees.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t ii = range.begin(); ii != range.end(); ++ii)
+          process(subtrees[ii]);
+      });
+      return ret;
+    }
+#endif
+    for (const auto& subtree : subtrees)
+      process(subtree);
+    return ret;
+  } // ... locate(...)
+
+  //! contains nullptr for each point outside of the grid view, \sa locate
   template <class PointContainerType>
   EntityVectorType operator()(const PointContainerType& points) const
   {
-    auto level = std::min(gridview_.grid().maxLevel(), start_level_);
-    auto range = DSC::entityRange(gridview_.grid().levelView(level));
-    return process(points, range);
-  }
+    const auto locations = locate(points);
+    EntityVectorType ret;
+    ret.reserve(locations.size());
+    for (const auto& location : locations) {
+      if (location.found)
+        ret.emplace_back(DSC::make_unique<EntityType>(grid_view_.grid().entity(location.seed)));
+      else
+        ret.emplace_back(nullptr);
+    }
+    return ret;
+  } // ... operator()(...)
 
 private:
-  template <class QuadpointContainerType, class RangeType>
-  EntityVectorType process(const QuadpointContainerType& quad_points, const RangeType& range) const
+  struct Subtree
   {
-    EntityVectorType ret;
+    EntitySeedType seed;
+    size_t begin; // into order
+    size_t end;
+  };
 
-    for (const auto& my_ent : range) {
-      const auto my_level    = my_ent.level();
-      const auto& geometry   = my_ent.geometry();
-      const auto& refElement = DSG::reference_element(geometry);
-      for (const auto& point : quad_points) {
-        if (refElement.checkInside(geometry.local(point))) {
-          // if I cannot descend further add this entity even if it's not my view
-          if (gridview_.grid().maxLevel() <= my_level || gridview_.contains(my_ent)) {
-            ret.emplace_back(my_ent);
-          } else {
-            const auto h_end   = my_ent.hend(my_level + 1);
-            const auto h_begin = my_ent.hbegin(my_level + 1);
-            const auto h_range = boost::make_iterator_range(h_begin, h_end);
-            const auto kids = process(QuadpointContainerType(1, point), h_range);
-            ret.insert(ret.end(), kids.begin(), kids.end());
-          }
-        }
+  //! moves the points inside of geometry to the front of order[begin, end), returns the end of those
+  template <class GeometryType, class PointContainerType>
+  static size_t sort_into(const GeometryType& geometry, const PointContainerType& points, std::vector<size_t>& order,
+                          const size_t begin, const size_t end)
+  {
+    const auto& reference_element = DSG::reference_element(geometry);
+    const auto inside = std::partition(order.begin() + begin, order.begin() + end, [&](const size_t ii) {
+      return reference_element.checkInside(geometry.local(points[ii]));
+    });
+    return size_t(inside - order.begin());
+  } // ... sort_into(...)
+
+  template <class PointContainerType>
+  void descend(const EntityType& entity, const PointContainerType& points, std::vector<size_t>& order, size_t begin,
+               const size_t end, LocationVectorType& ret) const
+  {
+    const int level = entity.level();
+    if (grid_view_.contains(entity) || entity.isLeaf() || level >= grid_view_.grid().maxLevel()) {
+      const auto geometry = entity.geometry();
+      const auto seed     = entity.seed();
+      for (size_t ii = begin; ii < end; ++ii) {
+        auto& location = ret[order[ii]];
+        location.found = true;
+        location.seed  = seed;
+        location.local = geometry.local(points[order[ii]]);
       }
+      return;
     }
-    return ret;
-  }
+    const auto children_end = entity.hend(level + 1);
+    for (auto child = entity.hbegin(level + 1); child != children_end && begin < end; ++child) {
+      const size_t child_end = sort_into(child->geometry(), points, order, begin, end);
+      if (child_end > begin) {
+        descend(*child, points, order, begin, child_end, ret);
+        begin = child_end;
+      }
+    }
+  } // ... descend(...)
+
+  const GridViewType grid_view_;
+  const int start_level_;
+  const EntityBoundingBoxSearch<LevelGridViewType> root_search_;
 }; // class EntityHierarchicSearch
 
 template <class GV>
@@ -164,9 +560,21 @@ EntityInlevelSearch<GV> make_entity_in_level_search(const GV& grid_view)
 }
 
 template <class GV>
-EntityHierarchicSearch<GV> make_entity_hierarchic_search(const GV& grid_view)
+EntityBoundingBoxSearch<GV> make_entity_bounding_box_search(const GV& grid_view)
+{
+  return EntityBoundingBoxSearch<GV>(grid_view);
+}
+
+template <class GV>
+EntityStructuredSearch<GV> make_entity_structured_search(const GV& grid_view)
+{
+  return EntityStructuredSearch<GV>(grid_view);
+}
+
+template <class GV>
+EntityHierarchicSearch<GV> make_entity_hierarchic_search(const GV& grid_view, const int start_level = 0)
 {
-  return EntityHierarchicSearch<GV>(grid_view);
+  return EntityHierarchicSearch<GV>(grid_view, start_level);
 }
 
 } // namespace Grid
@@ -8,34 +8,425 @@
 #ifndef DUNE_STUFF_GRID_PROVIDER_STARCD_HH
 #define DUNE_STUFF_GRID_PROVIDER_STARCD_HH
 
-#if HAVE_DUNE_GRID
-
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <memory>
+#include <numeric>
+#include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
 
-#include <boost/assign/list_of.hpp>
+#include <boost/filesystem.hpp>
+
+#if HAVE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
 
-#include <dune/common/shared_ptr.hh>
 #include <dune/common/exceptions.hh>
-#include <dune/common/parametertree.hh>
 #include <dune/common/fvector.hh>
 
+#if HAVE_DUNE_GRID
 #include <dune/geometry/type.hh>
 
 #include <dune/grid/common/gridfactory.hh>
-#include <dune/grid/utility/structuredgridfactory.hh>
-#include <dune/grid/sgrid.hh>
+#endif
 
 #include <dune/stuff/common/configuration.hh>
-#include <dune/stuff/common/string.hh>
 #include <dune/stuff/common/logging.hh>
+#include <dune/stuff/common/mapped-array.hh>
+#include <dune/stuff/common/memory.hh>
+#include <dune/stuff/common/parallel/threadmanager.hh>
+#include <dune/stuff/common/unused.hh>
+
+#if HAVE_DUNE_GRID
 #include <dune/stuff/grid/provider/interface.hh>
+#endif
 
 namespace Dune {
 namespace Stuff {
+namespace internal {
+
+//! Read-only memory mapping of a whole text file.
+class StarCDMappedFile
+{
+public:
+  explicit StarCDMappedFile(const std::string& filename)
+    : mapping_(nullptr)
+    , size_(0)
+  {
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      DUNE_THROW(Dune::IOError, "Could not open " << filename);
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0) {
+      ::close(fd);
+      DUNE_THROW(Dune::IOError, "Could not stat " << filename);
+    }
+    size_ = size_t(file_stat.st_size);
+    if (size_ > 0)
+      mapping_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping_ == MAP_FAILED) {
+      mapping_ = nullptr;
+      DUNE_THROW(Dune::IOError, "Could not map " << filename);
+    }
+    if (mapping_)
+      ::madvise(mapping_, size_, MADV_SEQUENTIAL);
+  } // StarCDMappedFile(...)
+
+  StarCDMappedFile(const StarCDMappedFile& other) = delete;
+
+  StarCDMappedFile& operator=(const StarCDMappedFile& other) = delete;
+
+  ~StarCDMappedFile()
+  {
+    if (mapping_)
+      ::munmap(mapping_, size_);
+  }
+
+  const char* begin() const { return static_cast<const char*>(mapping_); }
+
+  const char* end() const { return begin() + size_; }
+
+private:
+  void* mapping_;
+  size_t size_;
+}; // class StarCDMappedFile
+
+/**
+ * \brief Parses the vertex (.vrt) and cell (.cel) files of a StarCD mesh.
+ *
+ *        The files are memory mapped and the numbers are scanned in place, without copying lines into strings or
+ *        streams. The records are split into chunks (at line boundaries), which are parsed in parallel if use_tbb is
+ *        true. Since each record is written to its own slot of the result, the result does not depend on the number of
+ *        chunks.
+ */
+template <size_t dimDomain>
+class StarCDReader
+{
+public:
+  static const size_t max_corners = 8;
+  //! each cell is stored as its number of corners, followed by max_corners (0-based) vertex indices
+  static const size_t cell_stride = max_corners + 1;
+
+  //! \return the dimDomain coordinates of all vertices
+  static std::vector<double> read_vertices(const std::string& filename, const bool use_tbb = false)
+  {
+    const StarCDMappedFile file(filename);
+    const char* const data = skip_header(file, filename, "PROSTAR_VERTEX");
+    const auto chunks = split(data, file.end(), 1, use_tbb, filename);
+    std::vector<double> ret(chunks.num_records * dimDomain);
+    for_each_chunk(chunks, use_tbb, [&](const char* pos, const char* end, size_t record) {
+      for (; pos != end; ++record) {
+        const char* line     = pos;
+        const char* line_end = next_line(pos, end);
+        size_t num_items     = 0;
+        while (skip_blanks(line, line_end)) {
+          if (num_items == 0)
+            scan_integer(line, line_end, filename);
+          else if (num_items <= dimDomain)
+            ret[record * dimDomain + num_items - 1] = scan_double(line, line_end, filename);
+          else
+            break;
+          ++num_items;
+        }
+        if (num_items != dimDomain + 1 || skip_blanks(line, line_end))
+          DUNE_THROW(Dune::IOError,
+                     "Error: wrong number of items in line " << record + 3 << " of " << filename
+                                                             << " (should be dim + 1 = " << dimDomain + 1 << ")!");
+      }
+    });
+    return ret;
+  } // ... read_vertices(...)
+
+  /**
+   * \brief  Reads all cubes and (for dimDomain 3) prisms, \sa cell_stride.
+   *
+   *         The vertices of the cubes are reordered from StarCD to Dune numbering.
+   * \return The cells, each given by cell_stride entries.
+   */
+  static std::vector<unsigned int> read_cells(const std::string& filename, const bool use_tbb = false)
+  {
+    const size_t num_corners_cube = size_t(1) << dimDomain;
+    const StarCDMappedFile file(filename);
+    const char* const data = skip_header(file, filename, "PROSTAR_CELL");
+    const auto chunks = split(data, file.end(), 2, use_tbb, filename);
+    std::vector<unsigned int> ret(chunks.num_records * cell_stride, 0);
+    for_each_chunk(chunks, use_tbb, [&](const char* pos, const char* end, size_t record) {
+      for (; pos != end; ++record) {
+        const char* first_line     = pos;
+        const char* first_line_end = next_line(pos, end);
+        if (pos == end)
+          DUNE_THROW(Dune::IOError,
+                     "No vertex data available in file " << filename << " for element " << record + 1 << "!");
+        const char* second_line     = pos;
+        const char* second_line_end = next_line(pos, end);
+        if (!skip_blanks(first_line, first_line_end))
+          DUNE_THROW(Dune::IOError, "Elementindices do not correspond!");
+        const long first_index = scan_integer(first_line, first_line_end, filename);
+        // the element index, followed by the vertex indices, ignoring zeros
+        std::array<long, max_corners + 1> items;
+        size_t num_items = 0;
+        while (skip_blanks(second_line, second_line_end)) {
+          const long item = scan_integer(second_line, second_line_end, filename);
+          if (item == 0)
+            continue;
+          if (num_items == items.size())
+            DUNE_THROW(Dune::IOError, "Type of element " << record + 1 << " is not cube or prism!");
+          items[num_items++] = item;
+        }
+        if (num_items == 0 || first_index != items[0] || items[0] != long(record + 1))
+          DUNE_THROW(Dune::IOError, "Elementindices do not correspond!");
+        const size_t num_corners = num_items - 1;
+        if (num_corners != num_corners_cube && !(num_corners == 6 && dimDomain == 3))
+          DUNE_THROW(Dune::IOError, "Type of element " << record + 1 << " is not cube or prism!");
+        unsigned int* cell = ret.data() + record * cell_stride;
+        cell[0] = (unsigned int)(num_corners);
+        for (size_t kk = 0; kk < num_corners; ++kk) {
+          if (items[kk + 1] < 0)
+            DUNE_THROW(Dune::IOError, "Invalid vertex index in element " << record + 1 << " of " << filename << "!");
+          cell[kk + 1] = (unsigned int)(items[kk + 1] - 1);
+        }
+        if (num_corners == num_corners_cube) {
+          if (dimDomain > 1)
+            std::swap(cell[3], cell[4]);
+          if (dimDomain == 3)
+            std::swap(cell[7], cell[8]);
+        }
+      }
+    });
+    return ret;
+  } // ... read_cells(...)
+
+private:
+  struct ChunksType
+  {
+    //! chunk ii consists of the records in [bounds[ii], bounds[ii + 1]), starting with record first_record[ii]
+    std::vector<const char*> bounds;
+    std::vector<size_t> first_record;
+    size_t num_records;
+  }; // struct ChunksType
+
+  static bool is_blank(const char cc) { return cc == ' ' || cc == '\t' || cc == '\r'; }
+
+  //! moves pos to the next non blank character, \return false if the end of the line is reached
+  static bool skip_blanks(const char*& pos, const char* line_end)
+  {
+    while (pos != line_end && is_blank(*pos))
+      ++pos;
+    return pos != line_end;
+  }
+
+  //! moves pos to the beginning of the next line, \return the end of the current line (excluding the newline)
+  static const char* next_line(const char*& pos, const char* end)
+  {
+    const char* line_end = static_cast<const char*>(std::memchr(pos, '\n', size_t(end - pos)));
+    if (!line_end) {
+      pos = end;
+      return end;
+    }
+    pos = line_end + 1;
+    return line_end;
+  } // ... next_line(...)
+
+  static long scan_integer(const char*& pos, const char* line_end, const std::string& filename)
+  {
+    bool negative = false;
+    if (pos != line_end && (*pos == '-' || *pos == '+'))
+      negative = (*pos++ == '-');
+    const char* const first = pos;
+    long ret = 0;
+    while (pos != line_end && *pos >= '0' && *pos <= '9')
+      ret = 10 * ret + (*pos++ - '0');
+    if (pos == first || (pos != line_end && !is_blank(*pos)))
+      DUNE_THROW(Dune::IOError, "Invalid integer in " << filename << "!");
+    return negative ? -ret : ret;
+  } // ... scan_integer(...)
+
+  static double scan_double(const char*& pos, const char* line_end, const std::string& filename)
+  {
+    // strtod requires a terminated string, which the mapped file is not
+    char buffer[64];
+    size_t length = 0;
+    while (pos != line_end && !is_blank(*pos) && length + 1 < sizeof(buffer))
+      buffer[length++] = *pos++;
+    buffer[length] = '\0';
+    char* parsed_end = nullptr;
+    const double ret = std::strtod(buffer, &parsed_end);
+    if (length == 0 || parsed_end != buffer + length || (pos != line_end && !is_blank(*pos)))
+      DUNE_THROW(Dune::IOError, "Invalid number in " << filename << "!");
+    return ret;
+  } // ... scan_double(...)
+
+  //! checks the first line and skips the second one, \return the beginning of the data
+  static const char* skip_header(const StarCDMappedFile& file, const std::string& filename, const std::string& tag)
+  {
+    const char* pos      = file.begin();
+    const char* line_end = next_line(pos, file.end());
+    std::string line(file.begin(), line_end);
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+    if (line_end == file.end())
+      DUNE_THROW(Dune::IOError, "File " << filename << " is too short!");
+    if (line != tag)
+      DUNE_THROW(Dune::IOError,
+                 "First line of File " << filename << " (" << line << ") is not equal to '" << tag << "' !");
+    if (pos == file.end())
+      DUNE_THROW(Dune::IOError, "File " << filename << " is too short!");
+    next_line(pos, file.end());
+    return pos;
+  } // ... skip_header(...)
+
+  static void for_each_range(const size_t size, const bool use_tbb, const std::function<void(size_t)>& function)
+  {
+#if HAVE_TBB
+    if (use_tbb) {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, size), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t ii = range.begin(); ii != range.end(); ++ii)
+          function(ii);
+      });
+      return;
+    }
+#else
+    const auto DSC_UNUSED(no_warning_for_use_tbb) = use_tbb;
+#endif
+    for (size_t ii = 0; ii < size; ++ii)
+      function(ii);
+  } // ... for_each_range(...)
+
+  template <class FunctionType>
+  static void for_each_chunk(const ChunksType& chunks, const bool use_tbb, const FunctionType& function)
+  {
+    for_each_range(chunks.first_record.size(), use_tbb, [&](const size_t ii) {
+      function(chunks.bounds[ii], chunks.bounds[ii + 1], chunks.first_record[ii]);
+    });
+  }
+
+  /**
+   * \brief Splits [begin, end) into chunks of whole records of lines_per_record lines each.
+   *
+   *        The number of lines before each chunk is counted in parallel, to know the index of its first record.
+   */
+  static ChunksType split(const char* begin,
+                          const char* end,
+                          const size_t lines_per_record,
+                          const bool use_tbb,
+                          const std::string& filename)
+  {
+    const size_t num_chunks = use_tbb ? 4 * std::max(size_t(1), DS::threadManager().max_threads()) : 1;
+    ChunksType ret;
+    ret.bounds.resize(num_chunks + 1, end);
+    ret.bounds[0] = begin;
+    for (size_t ii = 1; ii < num_chunks; ++ii) {
+      const char* pos = std::max(ret.bounds[ii - 1], begin + (end - begin) * ii / num_chunks);
+      if (pos != begin && pos != end && pos[-1] != '\n')
+        next_line(pos, end);
+      ret.bounds[ii] = pos;
+    }
+    std::vector<size_t> first_line(num_chunks + 1, 0);
+    for_each_range(num_chunks, use_tbb, [&](const size_t ii) {
+      first_line[ii + 1] = size_t(std::count(ret.bounds[ii], ret.bounds[ii + 1], '\n'));
+    });
+    // a last line without a newline
+    if (begin != end && end[-1] != '\n')
+      ++first_line[num_chunks];
+    std::partial_sum(first_line.begin(), first_line.end(), first_line.begin());
+    if (first_line[num_chunks] % lines_per_record != 0)
+      DUNE_THROW(Dune::IOError, "Incomplete record at the end of " << filename << "!");
+    // move the bounds to the beginning of a record
+    for (size_t ii = 1; ii < num_chunks; ++ii) {
+      while (first_line[ii] % lines_per_record != 0) {
+        next_line(ret.bounds[ii], end);
+        ++first_line[ii];
+      }
+    }
+    ret.first_record.resize(num_chunks);
+    for (size_t ii = 0; ii < num_chunks; ++ii)
+      ret.first_record[ii] = first_line[ii] / lines_per_record;
+    ret.num_records = first_line[num_chunks] / lines_per_record;
+    return ret;
+  } // ... split(...)
+}; // class StarCDReader
+
+/**
+ * \brief The values read by parse from filename, or from its binary cache.
+ *
+ *        If use_cache is true and the cache (filename + ".bin") is valid and not older than filename, the cache is
+ *        memory mapped and filename is not parsed at all (and not even required to exist). Otherwise filename is parsed
+ *        and the cache is written, if use_cache is true.
+ */
+template <class T>
+class StarCDValues
+{
+public:
+  StarCDValues(const std::string& filename,
+               const std::string& tag,
+               const bool use_cache,
+               const std::function<std::vector<T>(const std::string&)>& parse)
+    : values_(nullptr)
+    , size_(0)
+  {
+    const std::string cache_filename = filename + ".bin";
+    if (use_cache && up_to_date(filename, cache_filename, tag)) {
+      mapped_values_ = Common::make_unique<Common::MappedArray<T>>(cache_filename, tag);
+      values_        = mapped_values_->data();
+      size_          = mapped_values_->size();
+      return;
+    }
+    parsed_values_ = parse(filename);
+    // the cache is optional, e.g. in read-only directories
+    if (use_cache)
+      Common::MappedArray<T>::write(cache_filename, parsed_values_.data(), parsed_values_.size(), tag);
+    values_ = parsed_values_.data();
+    size_   = parsed_values_.size();
+  } // StarCDValues(...)
+
+  StarCDValues(const StarCDValues& other) = delete;
+
+  StarCDValues& operator=(const StarCDValues& other) = delete;
+
+  const T* data() const { return values_; }
+
+  size_t size() const { return size_; }
+
+  //! true if the values were read from the cache
+  bool mapped() const { return bool(mapped_values_); }
+
+private:
+  static bool up_to_date(const std::string& filename, const std::string& cache_filename, const std::string& tag)
+  {
+    if (!Common::MappedArray<T>::is_valid(cache_filename, 0, tag))
+      return false;
+    // allow to use the cache on its own
+    boost::system::error_code error;
+    const auto source_time = boost::filesystem::last_write_time(filename, error);
+    if (error)
+      return true;
+    const auto cache_time = boost::filesystem::last_write_time(cache_filename, error);
+    return !error && cache_time >= source_time;
+  } // ... up_to_date(...)
+
+  std::vector<T> parsed_values_;
+  std::unique_ptr<const Common::MappedArray<T>> mapped_values_;
+  const T* values_;
+  size_t size_;
+}; // class StarCDValues
+
+} // namespace internal
+
+#if HAVE_DUNE_GRID
 
 /**
  * \brief   StarCD grid provider
@@ -58,6 +449,8 @@ public:
   static Common::Configuration default_config(const std::string sub_name = "")
   {
     Common::Configuration config("filename_prefix", "sample");
+    config["use_cache"] = "false";
+    config["use_tbb"]   = "false";
     if (sub_name.empty())
       return config;
     else {
@@ -72,108 +465,66 @@ public:
   {
     const Common::Configuration cfg         = config.has_sub(sub_name) ? config.sub(sub_name) : config;
     const Common::Configuration default_cfg = default_config();
-    return Common::make_unique<ThisType>(cfg.get("filename", default_cfg.get<std::string>("filename")));
+    return Common::make_unique<ThisType>(cfg.get("filename_prefix", default_cfg.get<std::string>("filename_prefix")),
+                                         cfg.get("use_cache", default_cfg.get<bool>("use_cache")),
+                                         cfg.get("use_tbb", default_cfg.get<bool>("use_tbb")));
   }
 
-  GridProviderStarCD(const std::string& filename)
+  /**
+   * \brief Reads filename + ".vrt" and filename + ".cel".
+   * \param use_cache If true, the parsed vertices and cells are stored in binary files next to the text files, which
+   *                  are used instead of the text files in subsequent runs, \sa internal::StarCDValues.
+   * \param use_tbb   If true, the text files are parsed in parallel.
+   */
+  GridProviderStarCD(const std::string& filename, const bool use_cache = false, const bool use_tbb = false)
   {
+    typedef internal::StarCDReader<dimDomain> ReaderType;
     std::ostream& out = Dune::Stuff::Common::Logger().devnull();
 
-    // set up the grid factory
-    GridFactory<GridType> factory;
-
     // read the vertices
     const std::string vertexFileName = filename + ".vrt";
-    std::ifstream vertexFile(vertexFileName);
-    if (!vertexFile)
-      DUNE_THROW(Dune::IOError, "Could not open " << vertexFileName);
-    std::string line;
-    if (!std::getline(vertexFile, line))
-      DUNE_THROW(Dune::IOError, "File " << vertexFileName << " is too short!");
-    if (!(line == "PROSTAR_VERTEX"))
-      DUNE_THROW(Dune::IOError,
-                 "First line of File " << vertexFileName << " (" << line << "is not equal to 'PROSTAR_VERTEX' !");
-    if (!std::getline(vertexFile, line))
-      DUNE_THROW(Dune::IOError, "File " << vertexFileName << " is too short!");
-    size_t numberOfVertices = 0;
-    Dune::FieldVector<double, dimDomain> position;
     out << "Reading " << vertexFileName << " ...   " << std::flush;
-    while (std::getline(vertexFile, line)) {
-      numberOfVertices++;
-      const std::vector<double> items = Dune::Stuff::Common::tokenize<double>(line, " ");
-      if (items.size() != dimDomain + 1)
-        DUNE_THROW(Dune::IOError, "Error: " << items.size() << " = items.size() != dim + 1 = " << dimDomain + 1 << "!");
-      for (size_t ii = 0; ii < dimDomain; ++ii)
-        position[ii] = items[ii + 1];
-      factory.insertVertex(position);
-    }
-    out << "done: " << numberOfVertices << " vertices read." << std::endl;
+    const internal::StarCDValues<double> vertices(
+        vertexFileName, "starcd.vertices." + std::to_string(dimDomain) + "d.v1", use_cache, [&](const std::string& fn) {
+          return ReaderType::read_vertices(fn, use_tbb);
+        });
+    const size_t numberOfVertices = vertices.size() / dimDomain;
+    out << "done: " << numberOfVertices << " vertices read" << (vertices.mapped() ? " from cache." : ".") << std::endl;
 
     // read the elements
-    std::string elementFileName = filename + ".cel";
-    std::ifstream elementFile(elementFileName);
-    if (!elementFile)
-      DUNE_THROW(Dune::IOError, "Could not open " << elementFileName);
-    if (!std::getline(elementFile, line))
-      DUNE_THROW(Dune::IOError, "File " << elementFileName << " is too short!");
-    if (!(line == "PROSTAR_CELL"))
-      DUNE_THROW(Dune::IOError,
-                 "First line of File " << elementFileName << " (" << line << "is not equal to 'PROSTAR_CELL' !");
-    if (!std::getline(elementFile, line))
-      DUNE_THROW(Dune::IOError, "File " << elementFileName << " is too short!");
-    size_t numberOfElements      = 0;
-    size_t numberOfPrisms        = 0;
-    size_t numberOfCubes         = 0;
-    size_t numberOfVerticesCube  = pow(2, dimDomain);
-    size_t numberOfVerticesPrism = 6;
-    std::vector<unsigned int> cubeVertices(numberOfVerticesCube); // unsigned int required by the grid factory
-    std::vector<unsigned int> prismVertices(numberOfVerticesPrism);
-    std::string firstLine;
-    std::string secondLine;
+    const std::string elementFileName = filename + ".cel";
     out << "Reading " << elementFileName << " ...   " << std::flush;
-    while (std::getline(elementFile, firstLine)) {
-      if (!std::getline(elementFile, secondLine))
-        DUNE_THROW(Dune::IOError,
-                   "No vertex data available in file " << elementFileName << " for element " << numberOfElements + 1
-                                                       << "!");
-      numberOfElements++;
-
-      const auto items1 = Dune::Stuff::Common::tokenize<int>(firstLine, " ");
-      auto items2       = Dune::Stuff::Common::tokenize<int>(secondLine, " ");
-
-      // Erase zeros at the beginning of the line
-      items2.erase(std::remove(items2.begin(), items2.end(), 0), items2.end());
-
-      if (!(items1[0] == items2[0]) || !(numberOfElements == items2[0]))
-        DUNE_THROW(Dune::IOError, "Elementindices do not correspond!");
-
-      if (items2.size() == numberOfVerticesCube + 1) { // cube
-        numberOfCubes++;
-        for (size_t k = 0; k < numberOfVerticesCube; k++)
-          cubeVertices[k] = items2[k + 1] - 1;
-        if (dimDomain > 1)
-          std::swap(cubeVertices[2], cubeVertices[3]);
-        if (dimDomain == 3)
-          std::swap(cubeVertices[6], cubeVertices[7]);
-        factory.insertElement(Dune::GeometryType(Dune::GeometryType::cube, dimDomain), cubeVertices);
-      } else if ((items2.size() == numberOfVerticesPrism + 1) && (dimDomain == 3)) { // prism
-        numberOfPrisms++;
-        for (size_t k = 0; k < numberOfVerticesPrism; k++)
-          prismVertices[k] = items2[k + 1] - 1;
-        factory.insertElement(Dune::GeometryType(Dune::GeometryType::prism, dimDomain), prismVertices);
-      } else // neither cube or prism
-        DUNE_THROW(Dune::IOError, "Type of element " << numberOfElements << " is not cube or prism!");
-    } // while loop
-
-    if (!(numberOfElements == (numberOfCubes + numberOfPrisms)))
-      DUNE_THROW(Dune::IOError,
-                 "Number of Elements (" << numberOfElements << ") is not equal to number of cubes (" << numberOfCubes
-                                        << ") and number of prisms ("
-                                        << numberOfPrisms
-                                        << ").");
+    const internal::StarCDValues<unsigned int> cells(
+        elementFileName, "starcd.cells." + std::to_string(dimDomain) + "d.v1", use_cache, [&](const std::string& fn) {
+          return ReaderType::read_cells(fn, use_tbb);
+        });
+    const size_t numberOfElements = cells.size() / ReaderType::cell_stride;
+    out << "done: " << numberOfElements << " elements read" << (cells.mapped() ? " from cache." : ".") << std::endl;
 
-    out << "done: " << numberOfElements << " elements read (" << numberOfPrisms << " prisms and " << numberOfCubes
-        << " cubes)." << std::endl;
+    // set up the grid factory
+    GridFactory<GridType> factory;
+    Dune::FieldVector<double, dimDomain> position;
+    for (size_t ii = 0; ii < numberOfVertices; ++ii) {
+      for (size_t dd = 0; dd < dimDomain; ++dd)
+        position[dd] = vertices.data()[ii * dimDomain + dd];
+      factory.insertVertex(position);
+    }
+    size_t numberOfPrisms = 0;
+    std::vector<unsigned int> elementVertices; // unsigned int required by the grid factory
+    for (size_t ii = 0; ii < numberOfElements; ++ii) {
+      const unsigned int* cell = cells.data() + ii * ReaderType::cell_stride;
+      elementVertices.assign(cell + 1, cell + 1 + cell[0]);
+      for (const auto& vertex : elementVertices)
+        if (vertex >= numberOfVertices)
+          DUNE_THROW(Dune::IOError, "Element " << ii + 1 << " references the unknown vertex " << vertex + 1 << "!");
+      if (cell[0] == 6 && dimDomain == 3) {
+        ++numberOfPrisms;
+        factory.insertElement(Dune::GeometryType(Dune::GeometryType::prism, dimDomain), elementVertices);
+      } else
+        factory.insertElement(Dune::GeometryType(Dune::GeometryType::cube, dimDomain), elementVertices);
+    }
+    out << "inserted " << numberOfElements << " elements (" << numberOfPrisms << " prisms and "
+        << numberOfElements - numberOfPrisms << " cubes)." << std::endl;
 
     // finish the construction of the grid object
     out << "Starting createGrid() ... " << std::endl;
@@ -213,9 +564,9 @@ private:
   std::shared_ptr<GridType> grid_;
 }; // class GridProviderStarCD
 
+#endif // HAVE_DUNE_GRID
+
 } // namespace Stuff
 } // namespace Dune
 
-#endif // HAVE_DUNE_GRID
-
 #endif // DUNE_STUFF_GRID_PROVIDER_STARCD_HH
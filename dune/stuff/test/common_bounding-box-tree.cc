@@ -0,0 +1,86 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <algorithm>
+#include <vector>
+
+#include <dune/stuff/common/bounding-box-tree.hh>
+#include <dune/stuff/common/random.hh>
+
+using namespace Dune::Stuff::Common;
+
+typedef testing::Types<Int<1>, Int<2>, Int<3>> Dimensions;
+
+template <class Dimension>
+struct BoundingBoxTreeTest : public ::testing::Test
+{
+  static const size_t dim = Dimension::value;
+  typedef BoundingBoxTree<double, dim> TreeType;
+  typedef typename TreeType::BoxType BoxType;
+  typedef typename TreeType::PointType PointType;
+
+  BoundingBoxTreeTest()
+    : center_rng_(0., 1.)
+    , radius_rng_(0.001, 0.05)
+  {
+  }
+
+  BoxType random_box()
+  {
+    BoxType box;
+    for (size_t dd = 0; dd < dim; ++dd) {
+      const auto center   = center_rng_();
+      const auto radius   = radius_rng_();
+      box.lower_left[dd]  = center - radius;
+      box.upper_right[dd] = center + radius;
+    }
+    return box;
+  }
+
+  void check()
+  {
+    std::vector<BoxType> boxes(2000);
+    std::generate(boxes.begin(), boxes.end(), [&]() { return random_box(); });
+    const TreeType tree(boxes);
+    EXPECT_EQ(boxes.size(), tree.size());
+    for (size_t query = 0; query < 100; ++query) {
+      // compare box queries to a linear search
+      const auto query_box = random_box();
+      std::vector<size_t> result;
+      tree.intersecting(query_box, result);
+      std::sort(result.begin(), result.end());
+      std::vector<size_t> expected;
+      for (size_t ii = 0; ii < boxes.size(); ++ii)
+        if (boxes[ii].intersects(query_box))
+          expected.push_back(ii);
+      EXPECT_EQ(expected, result);
+      // and point queries
+      const auto point = query_box.center();
+      result.clear();
+      tree.for_each_containing(point, [&](const size_t ii) {
+        result.push_back(ii);
+        return true;
+      });
+      std::sort(result.begin(), result.end());
+      expected.clear();
+      for (size_t ii = 0; ii < boxes.size(); ++ii)
+        if (boxes[ii].contains(point))
+          expected.push_back(ii);
+      EXPECT_EQ(expected, result);
+    }
+    // empty trees are fine
+    std::vector<size_t> result;
+    TreeType().intersecting(random_box(), result);
+    EXPECT_TRUE(result.empty());
+  } // ... check(...)
+
+  DefaultRNG<double> center_rng_;
+  DefaultRNG<double> radius_rng_;
+}; // struct BoundingBoxTreeTest
+
+TYPED_TEST_CASE(BoundingBoxTreeTest, Dimensions);
+TYPED_TEST(BoundingBoxTreeTest, queries) { this->check(); }
@@ -0,0 +1,97 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/stuff/common/mapped-array.hh>
+
+using namespace Dune::Stuff;
+using namespace Dune::Stuff::Common;
+
+TEST(MappedArrayTest, write_and_map)
+{
+  const std::string filename = "mapped_array_test.bin";
+  std::vector<double> values(1000);
+  for (size_t ii = 0; ii < values.size(); ++ii)
+    values[ii] = 0.5 * ii;
+  EXPECT_TRUE(MappedArray<double>::write(filename, values.data(), values.size()));
+  EXPECT_TRUE(MappedArray<double>::is_valid(filename));
+  EXPECT_TRUE(MappedArray<double>::is_valid(filename, values.size()));
+  EXPECT_FALSE(MappedArray<double>::is_valid(filename, values.size() + 1));
+  EXPECT_FALSE(MappedArray<float>::is_valid(filename));
+  {
+    const MappedArray<double> mapped(filename);
+    ASSERT_EQ(values.size(), mapped.size());
+    for (size_t ii = 0; ii < values.size(); ++ii)
+      EXPECT_EQ(values[ii], mapped[ii]);
+    EXPECT_EQ(values.size(), size_t(mapped.end() - mapped.begin()));
+  }
+  EXPECT_THROW(MappedArray<float>{filename}, Exceptions::wrong_input_given);
+  std::remove(filename.c_str());
+} // MappedArrayTest, write_and_map
+
+TEST(MappedArrayTest, tags)
+{
+  const std::string filename = "mapped_array_test_tagged.bin";
+  const std::vector<double> values(10, 1.);
+  EXPECT_TRUE(MappedArray<double>::write(filename, values.data(), values.size(), "values.v1"));
+  EXPECT_TRUE(MappedArray<double>::is_valid(filename, values.size(), "values.v1"));
+  EXPECT_FALSE(MappedArray<double>::is_valid(filename, values.size(), "values.v2"));
+  EXPECT_FALSE(MappedArray<double>::is_valid(filename));
+  EXPECT_EQ(values.size(), MappedArray<double>(filename, "values.v1").size());
+  EXPECT_THROW(MappedArray<double>(filename, "values.v2"), Exceptions::wrong_input_given);
+  EXPECT_THROW(MappedArray<double>(filename, std::string(33, 'a')), Exceptions::wrong_input_given);
+  std::remove(filename.c_str());
+} // MappedArrayTest, tags
+
+TEST(MappedArrayTest, invalid_files)
+{
+  const std::string filename = "mapped_array_test.txt";
+  EXPECT_FALSE(MappedArray<double>::is_valid(filename));
+  EXPECT_THROW(MappedArray<double>{filename}, Dune::IOError);
+  {
+    std::ofstream file(filename);
+    file << "0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0";
+  }
+  EXPECT_FALSE(MappedArray<double>::is_valid(filename));
+  EXPECT_THROW(MappedArray<double>{filename}, Exceptions::wrong_input_given);
+  std::remove(filename.c_str());
+} // MappedArrayTest, invalid_files
+
+TEST(MappedArrayTest, truncated_files)
+{
+  const std::string filename = "mapped_array_test_truncated.bin";
+  const std::vector<double> values(10, 1.);
+  EXPECT_TRUE(MappedArray<double>::write(filename, values.data(), values.size(), "values.v1"));
+  std::string contents;
+  {
+    std::ifstream file(filename, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  // a valid header followed by too few values
+  {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size() - sizeof(double) - 3));
+  }
+  EXPECT_FALSE(MappedArray<double>::is_valid(filename, 0, "values.v1"));
+  EXPECT_THROW(MappedArray<double>(filename, "values.v1"), Exceptions::wrong_input_given);
+  // trailing garbage is not accepted either
+  {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    file.write(contents.data(), static_cast<std::streamsize>(sizeof(double)));
+  }
+  EXPECT_FALSE(MappedArray<double>::is_valid(filename, 0, "values.v1"));
+  EXPECT_THROW(MappedArray<double>(filename, "values.v1"), Exceptions::wrong_input_given);
+  std::remove(filename.c_str());
+} // MappedArrayTest, truncated_files
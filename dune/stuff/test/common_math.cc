@@ -70,6 +70,14 @@ TYPED_TEST(MinMaxAvgTest, All)
   mmCheck<MinMaxAvg<TypeParam>, TypeParam>(mma);
   auto mmb = mma;
   mmCheck<MinMaxAvg<TypeParam>, TypeParam>(mmb);
+  // merging partial results gives the same as adding all values to one
+  MinMaxAvg<TypeParam> first, second;
+  first(-1);
+  first(1);
+  second(0);
+  second(-4);
+  first += second;
+  mmCheck<MinMaxAvg<TypeParam>, TypeParam>(first);
 }
 
 TEST(OtherMath, Range)
@@ -0,0 +1,59 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <vector>
+
+#include <dune/stuff/common/random.hh>
+
+using namespace Dune::Stuff::Common;
+
+TEST(Philox4x32Test, known_answers)
+{
+  // from the known answer tests of the reference implementation (Random123)
+  typedef Philox4x32::CounterType C;
+  typedef Philox4x32::KeyType K;
+  EXPECT_EQ(C({{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}), Philox4x32::block(C({{0, 0, 0, 0}}), K({{0, 0}})));
+  EXPECT_EQ(C({{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}),
+            Philox4x32::block(C({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}}), K({{0xffffffff, 0xffffffff}})));
+  EXPECT_EQ(C({{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}),
+            Philox4x32::block(C({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}}), K({{0xa4093822, 0x299f31d0}})));
+} // Philox4x32Test, known_answers
+
+TEST(Philox4x32Test, streams)
+{
+  Philox4x32 first(42, 0);
+  Philox4x32 second(42, 1);
+  Philox4x32 first_again(42, 0);
+  std::vector<Philox4x32::result_type> first_values;
+  size_t num_equal = 0;
+  for (size_t ii = 0; ii < 100; ++ii) {
+    first_values.push_back(first());
+    num_equal += (first_values.back() == second());
+    EXPECT_EQ(first_values.back(), first_again());
+  }
+  EXPECT_GT(size_t(2), num_equal);
+  // discard skips exactly the given number of values
+  for (size_t ii = 0; ii < 13; ++ii) {
+    Philox4x32 skipping(42, 0);
+    skipping.discard(ii);
+    EXPECT_EQ(first_values[ii], skipping());
+  }
+} // Philox4x32Test, streams
+
+TEST(CounterBasedRNGTest, order_independence)
+{
+  // generating the streams in any order gives the same numbers
+  std::vector<double> forward;
+  for (size_t ii = 0; ii < 10; ++ii)
+    forward.push_back(CounterBasedRNG<double>(0., 1., 1234, ii)());
+  for (size_t ii = 10; ii > 0; --ii) {
+    const double value = CounterBasedRNG<double>(0., 1., 1234, ii - 1)();
+    EXPECT_EQ(forward[ii - 1], value);
+    EXPECT_LE(0., value);
+    EXPECT_GT(1., value);
+  }
+} // CounterBasedRNGTest, order_independence
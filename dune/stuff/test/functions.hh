@@ -65,6 +65,11 @@ protected:
 #if HAVE_DUNE_GRID
     for (const auto& entity : Common::entityRange(grid.leafGridView()))
       std::unique_ptr<LocalfunctionType> local_func = func.local_function(entity);
+    std::unique_ptr<LocalfunctionType> reused_local_func;
+    for (const auto& entity : Common::entityRange(grid.leafGridView())) {
+      func.bind_local_function(reused_local_func, entity);
+      EXPECT_EQ(&entity, &reused_local_func->entity());
+    }
 #endif
     std::string tp = func.type();
     std::string nm = func.name();
@@ -0,0 +1,135 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#if HAVE_DUNE_GRID
+#include <dune/grid/yaspgrid.hh>
+#endif
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/grid/provider/cube.hh>
+#include <dune/stuff/functions/affinely_decomposable.hh>
+#include <dune/stuff/functions/constant.hh>
+#include <dune/stuff/functions/expression.hh>
+
+#include "functions.hh"
+
+#if HAVE_DUNE_GRID
+
+using namespace Dune;
+using namespace Stuff;
+
+template <class DimDomain>
+struct AffinelyDecomposableTypes
+{
+  typedef YaspGrid<DimDomain::value, EquidistantOffsetCoordinates<double, DimDomain::value>> GridType;
+  typedef typename GridType::template Codim<0>::Entity EntityType;
+  typedef Functions::AffinelyDecomposable<EntityType, double, DimDomain::value, double, 1> DecomposableType;
+  typedef typename DecomposableType::Parametrized value;
+  typedef Functions::Constant<EntityType, double, DimDomain::value, double, 1> ConstantType;
+  typedef Functions::Expression<EntityType, double, DimDomain::value, double, 1> ExpressionType;
+}; // struct AffinelyDecomposableTypes
+
+template <class DimDomain>
+class AffinelyDecomposableTest : public FunctionTest<typename AffinelyDecomposableTypes<DimDomain>::value>
+{
+protected:
+  typedef AffinelyDecomposableTypes<DimDomain> Types;
+  typedef typename Types::GridType GridType;
+  typedef typename Types::DecomposableType DecomposableType;
+  typedef typename Types::ConstantType ConstantType;
+  typedef typename Types::ExpressionType ExpressionType;
+  typedef typename DecomposableType::ParameterType ParameterType;
+
+  // f(x; mu) = 2 + mu_0 + mu_0 mu_1 x_0
+  AffinelyDecomposableTest()
+    : grid_(Stuff::Grid::Providers::Cube<GridType>(0.0, 1.0, 2).grid_ptr())
+    , one_(1.)
+    , function_(2)
+  {
+    std::vector<std::string> gradient(DimDomain::value, "0");
+    gradient[0] = "1";
+    function_.register_component(one_, [](const ParameterType& mu) { return mu[0]; });
+    function_.register_component(
+        std::make_shared<ExpressionType>("x", "x[0]", 1, "x_0", gradient),
+        [](const ParameterType& mu) { return mu[0] * mu[1]; });
+    function_.register_affine_part(std::make_shared<ConstantType>(2.));
+  }
+
+  static ParameterType parameter(const double mu_0, const double mu_1)
+  {
+    ParameterType mu(2);
+    mu[0] = mu_0;
+    mu[1] = mu_1;
+    return mu;
+  }
+
+  std::shared_ptr<GridType> grid_;
+  const ConstantType one_;
+  DecomposableType function_;
+}; // class AffinelyDecomposableTest
+
+typedef testing::Types<Int<1>, Int<2>, Int<3>> DimDomains;
+
+TYPED_TEST_CASE(AffinelyDecomposableTest, DimDomains);
+TYPED_TEST(AffinelyDecomposableTest, static_interface_check) { this->static_interface_check(); }
+TYPED_TEST(AffinelyDecomposableTest, dynamic_interface_check)
+{
+  const auto parametrized = this->function_.parametrized(this->parameter(1., 2.));
+  this->dynamic_interface_check(parametrized, *(this->grid_));
+}
+TYPED_TEST(AffinelyDecomposableTest, components_check)
+{
+  EXPECT_EQ(size_t(2), this->function_.num_components());
+  EXPECT_EQ(size_t(2), this->function_.parameter_size());
+  EXPECT_TRUE(this->function_.has_affine_part());
+  EXPECT_EQ(&this->one_, &this->function_.component(0));
+  EXPECT_EQ("x_0", this->function_.component(1).name());
+  const auto coefficients = this->function_.coefficients(this->parameter(3., 4.));
+  ASSERT_EQ(size_t(2), coefficients.size());
+  EXPECT_DOUBLE_EQ(3., coefficients[0]);
+  EXPECT_DOUBLE_EQ(12., coefficients[1]);
+  EXPECT_DOUBLE_EQ(12., this->function_.coefficient(1)(this->parameter(3., 4.)));
+  EXPECT_THROW(this->function_.component(2), Exceptions::index_out_of_range);
+  EXPECT_THROW(this->function_.coefficients(typename TestFixture::ParameterType(3)), Exceptions::wrong_input_given);
+  EXPECT_THROW(this->function_.register_affine_part(this->one_), Exceptions::you_are_using_this_wrong);
+  const typename TestFixture::DecomposableType without_affine_part(1);
+  EXPECT_THROW(without_affine_part.affine_part(), Exceptions::you_are_using_this_wrong);
+}
+TYPED_TEST(AffinelyDecomposableTest, evaluate_check)
+{
+  typedef typename TestFixture::DecomposableType::DomainType DomainType;
+  for (const auto& mu : {this->parameter(0., 0.), this->parameter(1., 2.), this->parameter(-0.5, 3.)}) {
+    const auto parametrized = this->function_.parametrized(mu);
+    EXPECT_EQ(mu, parametrized.parameter());
+    std::unique_ptr<typename TestFixture::LocalfunctionType> local_function;
+    for (const auto& entity : Common::entityRange(this->grid_->leafGridView())) {
+      parametrized.bind_local_function(local_function, entity);
+      EXPECT_EQ(size_t(1), local_function->order());
+      const DomainType xx_local(0.5);
+      const auto xx = entity.geometry().global(xx_local);
+      EXPECT_DOUBLE_EQ(2. + mu[0] + mu[0] * mu[1] * xx[0], local_function->evaluate(xx_local)[0]);
+      const auto jacobian = local_function->jacobian(xx_local);
+      EXPECT_DOUBLE_EQ(mu[0] * mu[1], jacobian[0][0]);
+      for (size_t dd = 1; dd < TypeParam::value; ++dd)
+        EXPECT_DOUBLE_EQ(0., jacobian[0][dd]);
+    }
+  }
+}
+
+#else // HAVE_DUNE_GRID
+
+// no-compile placeholders to mark disabled tests in test-binary output
+TEST(DISABLED_AffinelyDecomposableTest, static_interface_check) {}
+TEST(DISABLED_AffinelyDecomposableTest, dynamic_interface_check) {}
+TEST(DISABLED_AffinelyDecomposableTest, components_check) {}
+TEST(DISABLED_AffinelyDecomposableTest, evaluate_check) {}
+
+#endif // HAVE_DUNE_GRID
@@ -5,6 +5,10 @@
 
 #include "main.hxx"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 #include <memory>
 
 #include <dune/common/exceptions.hh>
@@ -33,6 +37,28 @@
     {                                                                                                                  \
       const std::unique_ptr<const LocalizableFunctionType> function(                                                   \
           LocalizableFunctionType::create(LocalizableFunctionType::default_config()));                                 \
+    }                                                                                                                  \
+                                                                                                                       \
+    void check_save_and_load() const                                                                                   \
+    {                                                                                                                  \
+      const std::unique_ptr<const LocalizableFunctionType> function(                                                   \
+          LocalizableFunctionType::create(LocalizableFunctionType::default_config()));                                 \
+      EXPECT_TRUE(function->save("checkerboard_test.bin"));                                                            \
+      typedef Dune::Stuff::Common::FieldVector<DomainFieldType, dimDomain> PointType;                                  \
+      typedef Dune::Stuff::Common::FieldVector<size_t, dimDomain> NumElementsType;                                     \
+      const auto loaded =                                                                                              \
+          LocalizableFunctionType::load("checkerboard_test.bin", PointType(0), PointType(1), NumElementsType(2));      \
+      EXPECT_TRUE(loaded->save("checkerboard_test_loaded.bin"));                                                       \
+      std::ifstream original("checkerboard_test.bin", std::ios::binary);                                               \
+      std::ifstream reloaded("checkerboard_test_loaded.bin", std::ios::binary);                                        \
+      EXPECT_TRUE(std::equal(std::istreambuf_iterator<char>(original),                                                 \
+                             std::istreambuf_iterator<char>(),                                                         \
+                             std::istreambuf_iterator<char>(reloaded)));                                               \
+      EXPECT_THROW(                                                                                                    \
+          LocalizableFunctionType::load("checkerboard_test.bin", PointType(0), PointType(1), NumElementsType(3)),      \
+          Dune::Stuff::Exceptions::wrong_input_given);                                                                 \
+      std::remove("checkerboard_test.bin");                                                                            \
+      std::remove("checkerboard_test_loaded.bin");                                                                     \
     }                                                                                                                  \
   };
 // TEST_STRUCT_GENERATOR
@@ -77,6 +103,81 @@ typedef testing::Types<Dune::Stuff::Functions::Checkerboard<DuneYaspGrid1dEntity
 TEST_STRUCT_GENERATOR(CheckerboardFunction, YaspGridEntity)
 TYPED_TEST_CASE(CheckerboardFunctionYaspGridEntityTest, CheckerboardFunctionYaspGridEntityTypes);
 TYPED_TEST(CheckerboardFunctionYaspGridEntityTest, provides_required_methods) { this->check(); }
+TYPED_TEST(CheckerboardFunctionYaspGridEntityTest, save_and_load) { this->check_save_and_load(); }
+
+TEST(CheckerboardStorageTest, compress_and_expand)
+{
+  using namespace Dune::Stuff::Functions;
+  typedef Dune::FieldMatrix<double, 2, 2> MatrixType;
+  MatrixType identity(0.);
+  identity[0][0] = identity[1][1] = 2.5;
+  MatrixType diagonal = identity;
+  diagonal[1][1]      = 0.5;
+  MatrixType full     = diagonal;
+  full[0][1]          = 1.;
+  MatrixType ret;
+  typedef CheckerboardStorage::ScalarTimesIdentity<double, 2, 2> ScalarType;
+  EXPECT_EQ(2.5, ScalarType::compress(identity));
+  ScalarType::expand(ScalarType::compress(identity), ret);
+  EXPECT_EQ(identity, ret);
+  EXPECT_THROW(ScalarType::compress(diagonal), Dune::Stuff::Exceptions::wrong_input_given);
+  typedef CheckerboardStorage::Diagonal<double, 2, 2, float> DiagonalType;
+  static_assert(sizeof(DiagonalType::StoredType) == 2 * sizeof(float), "");
+  DiagonalType::expand(DiagonalType::compress(diagonal), ret);
+  EXPECT_EQ(diagonal, ret);
+  EXPECT_THROW(DiagonalType::compress(full), Dune::Stuff::Exceptions::wrong_input_given);
+  typedef CheckerboardStorage::Full<double, 2, 2, float> FullType;
+  FullType::expand(FullType::compress(full), ret);
+  EXPECT_EQ(full, ret);
+  // values which are not representable as float are rounded
+  full[0][1] = 0.1;
+  FullType::expand(FullType::compress(full), ret);
+  EXPECT_FLOAT_EQ(0.1, ret[0][1]);
+  EXPECT_NE(0.1, ret[0][1]);
+} // CheckerboardStorageTest, compress_and_expand
+
+TEST(CheckerboardStorageTest, scalar_times_identity)
+{
+  using namespace Dune::Stuff::Functions;
+  typedef Checkerboard<DuneYaspGrid2dEntityType,
+                       double,
+                       2,
+                       double,
+                       2,
+                       2,
+                       CheckerboardStorage::ScalarTimesIdentity<double, 2, 2>>
+      CheckerboardType;
+  const auto function = CheckerboardType::create(CheckerboardType::default_config());
+  const std::vector<double> expected = {1., 2., 3., 4.};
+  EXPECT_EQ(expected, function->stored_values());
+} // CheckerboardStorageTest, scalar_times_identity
+
+TEST(CheckerboardStorageTest, save_and_load_surplus_values)
+{
+  using namespace Dune::Stuff::Functions;
+  typedef Checkerboard<DuneYaspGrid2dEntityType,
+                       double,
+                       2,
+                       double,
+                       1,
+                       1,
+                       CheckerboardStorage::ScalarTimesIdentity<double, 1, 1>>
+      CheckerboardType;
+  typedef Dune::Stuff::Common::FieldVector<double, 2> PointType;
+  typedef Dune::Stuff::Common::FieldVector<size_t, 2> NumElementsType;
+  // more values than cells are allowed, only those of the cells are saved
+  std::vector<CheckerboardType::RangeType> values;
+  for (size_t ii = 0; ii < 6; ++ii)
+    values.emplace_back(double(ii + 1));
+  const CheckerboardType function(PointType(0), PointType(1), NumElementsType(2), values);
+  ASSERT_EQ(size_t(6), function.stored_values().size());
+  EXPECT_TRUE(function.save("checkerboard_test_surplus.bin"));
+  const auto loaded =
+      CheckerboardType::load("checkerboard_test_surplus.bin", PointType(0), PointType(1), NumElementsType(2));
+  std::remove("checkerboard_test_surplus.bin");
+  const std::vector<double> expected = {1., 2., 3., 4.};
+  EXPECT_EQ(expected, loaded->stored_values());
+} // CheckerboardStorageTest, save_and_load_surplus_values
 
 #if HAVE_ALUGRID
 #include <dune/grid/alugrid.hh>
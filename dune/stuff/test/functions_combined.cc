@@ -92,6 +92,30 @@ TYPED_TEST(DifferenceFunctionTest, evaluate_check)
     }
   }
 } // DifferenceFunctionTest, evaluate_check
+TYPED_TEST(DifferenceFunctionTest, fused_evaluate_check)
+{
+  typedef typename TestFixture::GridType GridType;
+  typedef typename DifferenceFunctionType<GridType>::ConstantFunctionType ConstantFunctionType;
+  typedef typename TestFixture::FunctionType DifferenceType;
+  typedef Functions::Product<ConstantFunctionType, Functions::Sum<ConstantFunctionType, DifferenceType>> NestedType;
+  auto grid_ptr = this->create_grid();
+  // 2 * (3 + (1 - 2)), all operands are of concrete type and thus fused into one local function
+  const ConstantFunctionType two(2);
+  const ConstantFunctionType three(3);
+  const auto difference = this->create(1.0, 2.0);
+  const auto sum        = Functions::make_sum(three, *difference);
+  const NestedType nested(two, *sum);
+  std::unique_ptr<typename NestedType::LocalfunctionType> local_func;
+  for (const auto& entity : Stuff::Common::entityRange(grid_ptr->leafGridView())) {
+    nested.bind_local_function(local_func, entity);
+    EXPECT_TRUE(local_func->is_bindable());
+    EXPECT_EQ(&entity, &local_func->entity());
+    EXPECT_EQ(size_t(0), local_func->order());
+    const auto& quadrature = QuadratureRules<double, TypeParam::value>::rule(entity.type(), 2);
+    for (const auto& element : quadrature)
+      EXPECT_EQ(4.0, local_func->evaluate(element.position())[0]);
+  }
+} // DifferenceFunctionTest, fused_evaluate_check
 
 #else // HAVE_DUNE_GRID
 
@@ -99,5 +123,6 @@ TYPED_TEST(DifferenceFunctionTest, evaluate_check)
 TEST(DISABLED_FlatTopFunctionTest, static_interface_check) {}
 TEST(DISABLED_DifferenceFunctionTest, dynamic_interface_check) {}
 TEST(DISABLED_DifferenceFunctionTest, evaluate_check) {}
+TEST(DISABLED_DifferenceFunctionTest, fused_evaluate_check) {}
 
 #endif // HAVE_DUNE_GRID
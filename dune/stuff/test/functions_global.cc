@@ -9,8 +9,10 @@
 
 #include <dune/common/exceptions.hh>
 
+#include <dune/stuff/common/ranges.hh>
 #include <dune/stuff/functions/interfaces.hh>
 #include <dune/stuff/functions/global.hh>
+#include <dune/stuff/grid/provider/cube.hh>
 
 // we need this nasty code generation because the testing::Types< ... > only accepts 50 arguments
 // and all combinations of functions and entities and dimensions and fieldtypes would be way too much
@@ -82,6 +84,46 @@ TEST_STRUCT_GENERATOR(GlobalLambdaFunctionTest, YaspGridEntity)
 TYPED_TEST_CASE(GlobalLambdaFunctionTestYaspGridEntityTest, GlobalLambdaFunctionYaspGridEntityTypes);
 TYPED_TEST(GlobalLambdaFunctionTestYaspGridEntityTest, provides_required_methods) { this->check(); }
 
+template <class DimDomain>
+struct InlineGlobalLambdaFunctionTest : public ::testing::Test
+{
+  static const size_t d = DimDomain::value;
+  typedef Dune::YaspGrid<d, Dune::EquidistantOffsetCoordinates<double, d>> GridType;
+  typedef typename GridType::template Codim<0>::Entity EntityType;
+  typedef Dune::FieldVector<double, d> DomainType;
+  typedef Dune::FieldVector<double, 2> RangeType;
+
+  void check() const
+  {
+    const double factor = 2.;
+    const auto function = Dune::Stuff::make_inline_global_lambda_function<EntityType, double, d, double, 2>(
+        [=](const DomainType& xx) {
+          RangeType ret(factor);
+          ret[1] *= xx[0];
+          return ret;
+        },
+        1,
+        "inline");
+    const Dune::Stuff::GlobalFunctionInterface<EntityType, double, d, double, 2, 1>& interface_function = function;
+    EXPECT_EQ("inline", function.name());
+    EXPECT_EQ(size_t(1), interface_function.order());
+    const auto grid = Dune::Stuff::Grid::Providers::Cube<GridType>(0.0, 1.0, 2).grid_ptr();
+    for (const auto& entity : Dune::Stuff::Common::entityRange(grid->leafGridView())) {
+      const auto local_function = interface_function.local_function(entity);
+      const DomainType xx_local(0.25);
+      const auto xx = entity.geometry().global(xx_local);
+      EXPECT_EQ(interface_function.evaluate(xx), function(xx));
+      EXPECT_EQ(local_function->evaluate(xx_local), function.local_evaluate(entity, xx_local));
+      EXPECT_DOUBLE_EQ(factor * xx[0], function(xx)[1]);
+    }
+  } // ... check(...)
+}; // struct InlineGlobalLambdaFunctionTest
+
+typedef testing::Types<Int<1>, Int<2>, Int<3>> DimDomains;
+
+TYPED_TEST_CASE(InlineGlobalLambdaFunctionTest, DimDomains);
+TYPED_TEST(InlineGlobalLambdaFunctionTest, provides_required_methods) { this->check(); }
+
 #if HAVE_ALUGRID
 #include <dune/stuff/common/disable_warnings.hh>
 #include <dune/grid/alugrid.hh>
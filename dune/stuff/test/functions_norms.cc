@@ -0,0 +1,103 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#if HAVE_DUNE_GRID
+#include <dune/grid/yaspgrid.hh>
+#endif
+
+#include <dune/stuff/grid/provider/cube.hh>
+#include <dune/stuff/functions/constant.hh>
+#include <dune/stuff/functions/expression.hh>
+#include <dune/stuff/functions/norms.hh>
+
+#if HAVE_DUNE_GRID
+
+using namespace Dune;
+using namespace Stuff;
+
+template <class DimDomain>
+class NormIntegratorTest : public ::testing::Test
+{
+protected:
+  static const size_t d = DimDomain::value;
+  typedef YaspGrid<d, EquidistantOffsetCoordinates<double, d>> GridType;
+  typedef typename GridType::LeafGridView GridViewType;
+  typedef typename GridType::template Codim<0>::Entity EntityType;
+  typedef Functions::Expression<EntityType, double, d, double, 1> ExpressionType;
+  typedef Functions::Constant<EntityType, double, d, double, 1> ConstantType;
+  typedef Functions::Constant<EntityType, double, d, double, d, d> MatrixConstantType;
+  typedef Functions::NormIntegrator<GridViewType> IntegratorType;
+
+  // f(x) = x_0
+  NormIntegratorTest()
+    : grid_(Stuff::Grid::Providers::Cube<GridType>(0.0, 1.0, 4).grid_ptr())
+    , function_("x", "x[0]", 1, "x_0", gradient())
+    , one_(1.)
+  {
+  }
+
+  static std::vector<std::string> gradient()
+  {
+    std::vector<std::string> ret(d, "0");
+    ret[0] = "1";
+    return ret;
+  }
+
+  std::shared_ptr<GridType> grid_;
+  const ExpressionType function_;
+  const ConstantType one_;
+}; // class NormIntegratorTest
+
+typedef testing::Types<Int<1>, Int<2>, Int<3>> DimDomains;
+
+TYPED_TEST_CASE(NormIntegratorTest, DimDomains);
+TYPED_TEST(NormIntegratorTest, norms_check)
+{
+  const typename TestFixture::IntegratorType integrator(this->grid_->leafGridView());
+  EXPECT_DOUBLE_EQ(std::sqrt(1. / 3.), integrator.l2(this->function_));
+  EXPECT_DOUBLE_EQ(1., integrator.l2(this->one_));
+  EXPECT_DOUBLE_EQ(1., integrator.h1_semi(this->function_));
+  EXPECT_DOUBLE_EQ(0., integrator.h1_semi(this->one_));
+  EXPECT_DOUBLE_EQ(std::sqrt(4. / 3.), integrator.h1(this->function_));
+  EXPECT_LT(0.9, integrator.linf(this->function_));
+  EXPECT_GE(1., integrator.linf(this->function_));
+  EXPECT_DOUBLE_EQ(std::sqrt(2.), integrator.energy(typename TestFixture::ConstantType(2.), this->function_));
+  // only the (0, 0) entry contributes for f(x) = x_0
+  EXPECT_DOUBLE_EQ(std::sqrt(3.), integrator.energy(typename TestFixture::MatrixConstantType(3.), this->function_));
+}
+TYPED_TEST(NormIntegratorTest, errors_check)
+{
+  const typename TestFixture::IntegratorType integrator(this->grid_->leafGridView());
+  EXPECT_DOUBLE_EQ(0., integrator.l2(this->function_, this->function_));
+  EXPECT_DOUBLE_EQ(std::sqrt(1. / 3.), integrator.l2(this->function_, this->one_));
+  EXPECT_DOUBLE_EQ(1., integrator.h1_semi(this->function_, this->one_));
+  EXPECT_DOUBLE_EQ(1., integrator.linf(this->one_, this->function_) + integrator.linf(this->function_));
+  EXPECT_DOUBLE_EQ(0., integrator.energy(this->one_, this->function_, this->function_));
+}
+TYPED_TEST(NormIntegratorTest, parallel_check)
+{
+  const typename TestFixture::IntegratorType sequential(this->grid_->leafGridView());
+  const auto parallel = Functions::make_norm_integrator(this->grid_->leafGridView(), 2, true);
+  // the results do not depend on the number of threads
+  EXPECT_EQ(sequential.l2(this->function_), parallel.l2(this->function_));
+  EXPECT_EQ(sequential.h1_semi(this->function_), parallel.h1_semi(this->function_));
+  EXPECT_EQ(sequential.linf(this->function_), parallel.linf(this->function_));
+  EXPECT_EQ(sequential.energy(this->one_, this->function_), parallel.energy(this->one_, this->function_));
+}
+
+#else // HAVE_DUNE_GRID
+
+// no-compile placeholders to mark disabled tests in test-binary output
+TEST(DISABLED_NormIntegratorTest, norms_check) {}
+TEST(DISABLED_NormIntegratorTest, errors_check) {}
+TEST(DISABLED_NormIntegratorTest, parallel_check) {}
+
+#endif // HAVE_DUNE_GRID
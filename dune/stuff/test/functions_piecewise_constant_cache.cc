@@ -0,0 +1,118 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <memory>
+
+#if HAVE_DUNE_GRID
+#include <dune/grid/yaspgrid.hh>
+#endif
+
+#include <dune/geometry/referenceelements.hh>
+
+#include <dune/stuff/common/float_cmp.hh>
+#include <dune/stuff/grid/provider/cube.hh>
+#include <dune/stuff/functions/checkerboard.hh>
+#include <dune/stuff/functions/piecewise_constant_cache.hh>
+
+#include "functions.hh"
+
+#if HAVE_DUNE_GRID
+
+using namespace Dune;
+using namespace Stuff;
+
+template <class DimDomain>
+struct PiecewiseConstantCacheTypes
+{
+  typedef YaspGrid<DimDomain::value, EquidistantOffsetCoordinates<double, DimDomain::value>> GridType;
+  typedef typename GridType::LeafGridView GridViewType;
+  typedef Functions::Checkerboard<typename GridType::template Codim<0>::Entity, double, DimDomain::value, double, 1, 1>
+      CheckerboardType;
+  typedef Functions::PiecewiseConstantCache<GridViewType, CheckerboardType> value;
+}; // struct PiecewiseConstantCacheTypes
+
+template <class DimDomain>
+class PiecewiseConstantCacheTest : public FunctionTest<typename PiecewiseConstantCacheTypes<DimDomain>::value>
+{
+protected:
+  typedef PiecewiseConstantCacheTypes<DimDomain> Types;
+  typedef typename Types::GridType GridType;
+  typedef typename Types::CheckerboardType CheckerboardType;
+  typedef typename Types::value CacheType;
+
+  PiecewiseConstantCacheTest()
+    : grid_(Stuff::Grid::Providers::Cube<GridType>(0.0, 1.0, 4).grid_ptr())
+    , checkerboard_(CheckerboardType::create(CheckerboardType::default_config()))
+  {
+  }
+
+  void values_check(const CacheType& cache) const
+  {
+    // callers only knowing the interface rebind the same local function
+    const LocalizableFunctionInterface<typename CacheType::EntityType, double, DimDomain::value, double, 1, 1>&
+        interface = cache;
+    std::unique_ptr<typename CacheType::LocalfunctionType> bound_local_function;
+    for (const auto& entity : Common::entityRange(grid_->leafGridView())) {
+      const auto& center = ReferenceElements<double, DimDomain::value>::general(entity.type()).position(0, 0);
+      const auto expected = checkerboard_->local_function(entity)->evaluate(center);
+      EXPECT_TRUE(Common::FloatCmp::eq(cache.local_function(entity)->evaluate(center), expected));
+      const auto* previous_local_function = bound_local_function.get();
+      interface.bind_local_function(bound_local_function, entity);
+      if (previous_local_function && cache.valid())
+        EXPECT_EQ(previous_local_function, bound_local_function.get());
+      EXPECT_TRUE(Common::FloatCmp::eq(bound_local_function->evaluate(center), expected));
+      if (cache.valid())
+        EXPECT_TRUE(Common::FloatCmp::eq(cache.value(entity), expected));
+    }
+  } // ... values_check(...)
+
+  std::shared_ptr<GridType> grid_;
+  std::shared_ptr<const CheckerboardType> checkerboard_;
+}; // class PiecewiseConstantCacheTest
+
+typedef testing::Types<Int<1>, Int<2>, Int<3>> DimDomains;
+
+TYPED_TEST_CASE(PiecewiseConstantCacheTest, DimDomains);
+TYPED_TEST(PiecewiseConstantCacheTest, static_interface_check) { this->static_interface_check(); }
+TYPED_TEST(PiecewiseConstantCacheTest, dynamic_interface_check)
+{
+  const typename TestFixture::CacheType cache(this->grid_->leafGridView(), this->checkerboard_);
+  this->dynamic_interface_check(cache, *(this->grid_));
+}
+TYPED_TEST(PiecewiseConstantCacheTest, evaluate_check)
+{
+  const typename TestFixture::CacheType cache(this->grid_->leafGridView(), this->checkerboard_);
+  EXPECT_TRUE(cache.valid());
+  EXPECT_EQ(this->grid_->leafGridView().indexSet().size(0), cache.values().size());
+  this->values_check(cache);
+}
+TYPED_TEST(PiecewiseConstantCacheTest, parallel_evaluate_check)
+{
+  const typename TestFixture::CacheType cache(this->grid_->leafGridView(), this->checkerboard_, true);
+  this->values_check(cache);
+}
+TYPED_TEST(PiecewiseConstantCacheTest, update_check)
+{
+  typename TestFixture::CacheType cache(this->grid_->leafGridView(), this->checkerboard_);
+  this->grid_->globalRefine(1);
+  EXPECT_FALSE(cache.valid());
+  this->values_check(cache);
+  cache.update();
+  EXPECT_TRUE(cache.valid());
+  this->values_check(cache);
+}
+
+#else // HAVE_DUNE_GRID
+
+// no-compile placeholders to mark disabled tests in test-binary output
+TEST(DISABLED_PiecewiseConstantCacheTest, static_interface_check) {}
+TEST(DISABLED_PiecewiseConstantCacheTest, dynamic_interface_check) {}
+TEST(DISABLED_PiecewiseConstantCacheTest, evaluate_check) {}
+TEST(DISABLED_PiecewiseConstantCacheTest, parallel_evaluate_check) {}
+TEST(DISABLED_PiecewiseConstantCacheTest, update_check) {}
+
+#endif // HAVE_DUNE_GRID
@@ -0,0 +1,217 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <atomic>
+
+#if HAVE_DUNE_GRID
+#include <dune/grid/yaspgrid.hh>
+#endif
+
+#include <dune/geometry/quadraturerules.hh>
+
+#include <dune/stuff/common/float_cmp.hh>
+#include <dune/stuff/common/ranges.hh>
+#include <dune/stuff/grid/provider/cube.hh>
+#include <dune/stuff/grid/walker.hh>
+#include <dune/stuff/functions/interfaces.hh>
+#include <dune/stuff/functions/quadrature_cache.hh>
+
+#if HAVE_DUNE_GRID
+
+using namespace Dune;
+using namespace Stuff;
+
+// x -> x[0], counts all evaluations, the first num_failures evaluations throw
+template <class EntityType, size_t d>
+class CountingFunction : public GlobalFunctionInterface<EntityType, double, d, double, 1>
+{
+  typedef GlobalFunctionInterface<EntityType, double, d, double, 1> BaseType;
+
+public:
+  using typename BaseType::DomainType;
+  using typename BaseType::RangeType;
+  using typename BaseType::JacobianRangeType;
+
+  CountingFunction()
+    : num_evaluations(0)
+    , num_jacobians(0)
+    , num_failures(0)
+  {
+  }
+
+  virtual size_t order() const override final { return 1; }
+
+  virtual void evaluate(const DomainType& xx, RangeType& ret) const override final
+  {
+    ++num_evaluations;
+    int failures = num_failures.load();
+    while (failures > 0 && !num_failures.compare_exchange_weak(failures, failures - 1))
+      ;
+    if (failures > 0)
+      DUNE_THROW(InvalidStateException, "failing on purpose");
+    ret = xx[0];
+  }
+
+  virtual void jacobian(const DomainType& /*xx*/, JacobianRangeType& ret) const override final
+  {
+    ++num_jacobians;
+    ret       = 0;
+    ret[0][0] = 1;
+  }
+
+  mutable std::atomic<size_t> num_evaluations;
+  mutable std::atomic<size_t> num_jacobians;
+  mutable std::atomic<int> num_failures;
+}; // class CountingFunction
+
+template <class DimDomain>
+class QuadratureCacheTest : public ::testing::Test
+{
+protected:
+  typedef YaspGrid<DimDomain::value, EquidistantOffsetCoordinates<double, DimDomain::value>> GridType;
+  typedef typename GridType::LeafGridView GridViewType;
+  typedef typename GridType::template Codim<0>::Entity EntityType;
+  typedef CountingFunction<EntityType, DimDomain::value> FunctionType;
+  typedef Functions::QuadratureCache<GridViewType, FunctionType> CacheType;
+  typedef typename CacheType::QuadratureType QuadratureType;
+
+  QuadratureCacheTest()
+    : grid_(Stuff::Grid::Providers::Cube<GridType>(0.0, 1.0, 4).grid_ptr())
+    , num_entities_(grid_->leafGridView().indexSet().size(0))
+  {
+  }
+
+  static const QuadratureType& quadrature(const EntityType& entity, const int order = 2)
+  {
+    return QuadratureRules<double, DimDomain::value>::rule(entity.type(), order);
+  }
+
+  // requests all values and jacobians and checks them
+  void request_all(const CacheType& cache, const int order = 2) const
+  {
+    for (const auto& entity : Common::entityRange(grid_->leafGridView())) {
+      const auto& quad      = quadrature(entity, order);
+      const auto* values    = cache.values(entity, quad);
+      const auto* jacobians = cache.jacobians(entity, quad);
+      for (size_t ii = 0; ii < quad.size(); ++ii) {
+        EXPECT_TRUE(Common::FloatCmp::eq(values[ii][0], entity.geometry().global(quad[ii].position())[0]));
+        EXPECT_TRUE(Common::FloatCmp::eq(jacobians[ii][0][0], 1.0));
+      }
+    }
+  } // ... request_all(...)
+
+  size_t num_points(const int order = 2) const
+  {
+    const auto entity = *grid_->leafGridView().template begin<0>();
+    return quadrature(entity, order).size();
+  }
+
+  std::shared_ptr<GridType> grid_;
+  const size_t num_entities_;
+  FunctionType function_;
+}; // class QuadratureCacheTest
+
+typedef testing::Types<Int<1>, Int<2>, Int<3>> DimDomains;
+
+TYPED_TEST_CASE(QuadratureCacheTest, DimDomains);
+TYPED_TEST(QuadratureCacheTest, values_check)
+{
+  const typename TestFixture::CacheType cache(this->grid_->leafGridView(), this->function_);
+  this->request_all(cache);
+  EXPECT_EQ(this->num_entities_ * this->num_points(), size_t(this->function_.num_evaluations));
+  EXPECT_EQ(this->num_entities_ * this->num_points(), size_t(this->function_.num_jacobians));
+  EXPECT_LT(size_t(0), cache.memory_usage());
+  // all further requests are served from the cache
+  this->request_all(cache);
+  EXPECT_EQ(this->num_entities_ * this->num_points(), size_t(this->function_.num_evaluations));
+  EXPECT_EQ(this->num_entities_ * this->num_points(), size_t(this->function_.num_jacobians));
+  // another quadrature rule has its own values
+  this->request_all(cache, 4);
+  EXPECT_EQ(this->num_entities_ * (this->num_points() + this->num_points(4)), size_t(this->function_.num_evaluations));
+}
+TYPED_TEST(QuadratureCacheTest, parallel_check)
+{
+  const typename TestFixture::CacheType cache(this->grid_->leafGridView(), this->function_);
+  Stuff::Grid::Walker<typename TestFixture::GridViewType> walker(this->grid_->leafGridView());
+  walker.add([&](const typename TestFixture::EntityType& entity) {
+    cache.values(entity, this->quadrature(entity));
+    cache.values(entity, this->quadrature(entity));
+  });
+  walker.walk(true);
+  EXPECT_EQ(this->num_entities_ * this->num_points(), size_t(this->function_.num_evaluations));
+  this->request_all(cache);
+}
+TYPED_TEST(QuadratureCacheTest, failure_check)
+{
+  const typename TestFixture::CacheType cache(this->grid_->leafGridView(), this->function_);
+  const auto entity = *this->grid_->leafGridView().template begin<0>();
+  this->function_.num_failures = 1;
+  EXPECT_THROW(cache.values(entity, this->quadrature(entity)), InvalidStateException);
+  // the values of a failed evaluation are recomputed, also by threads which waited for the failing one
+  this->function_.num_failures = 8;
+  Stuff::Grid::Walker<typename TestFixture::GridViewType> walker(this->grid_->leafGridView());
+  walker.add([&](const typename TestFixture::EntityType& en) {
+    bool done = false;
+    while (!done) {
+      try {
+        cache.values(en, this->quadrature(en));
+        done = true;
+      } catch (InvalidStateException&) {
+      }
+    }
+  });
+  walker.walk(true);
+  EXPECT_EQ(0, int(this->function_.num_failures));
+  this->request_all(cache);
+}
+TYPED_TEST(QuadratureCacheTest, budget_check)
+{
+  const typename TestFixture::CacheType cache(this->grid_->leafGridView(), this->function_, 0);
+  this->request_all(cache);
+  this->request_all(cache);
+  EXPECT_EQ(size_t(0), cache.memory_usage());
+  EXPECT_EQ(2 * this->num_entities_ * this->num_points(), size_t(this->function_.num_evaluations));
+}
+TYPED_TEST(QuadratureCacheTest, invalidate_check)
+{
+  typename TestFixture::CacheType cache(this->grid_->leafGridView(), this->function_);
+  this->request_all(cache);
+  const auto entity = *this->grid_->leafGridView().template begin<0>();
+  cache.invalidate(entity);
+  this->request_all(cache);
+  EXPECT_EQ((this->num_entities_ + 1) * this->num_points(), size_t(this->function_.num_evaluations));
+  cache.invalidate();
+  EXPECT_EQ(size_t(0), cache.memory_usage());
+  this->request_all(cache);
+  EXPECT_EQ((2 * this->num_entities_ + 1) * this->num_points(), size_t(this->function_.num_evaluations));
+}
+TYPED_TEST(QuadratureCacheTest, grid_change_check)
+{
+  typename TestFixture::CacheType cache(this->grid_->leafGridView(), this->function_);
+  this->request_all(cache);
+  this->grid_->globalRefine(1);
+  const size_t num_fine_entities = this->grid_->leafGridView().indexSet().size(0);
+  // the outdated values must not be used
+  this->request_all(cache);
+  cache.invalidate();
+  this->request_all(cache);
+  this->request_all(cache);
+  EXPECT_EQ((this->num_entities_ + 2 * num_fine_entities) * this->num_points(),
+            size_t(this->function_.num_evaluations));
+}
+
+#else // HAVE_DUNE_GRID
+
+// no-compile placeholders to mark disabled tests in test-binary output
+TEST(DISABLED_QuadratureCacheTest, values_check) {}
+TEST(DISABLED_QuadratureCacheTest, parallel_check) {}
+TEST(DISABLED_QuadratureCacheTest, failure_check) {}
+TEST(DISABLED_QuadratureCacheTest, budget_check) {}
+TEST(DISABLED_QuadratureCacheTest, invalidate_check) {}
+TEST(DISABLED_QuadratureCacheTest, grid_change_check) {}
+
+#endif // HAVE_DUNE_GRID
@@ -0,0 +1,177 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#if HAVE_DUNE_GRID
+#include <dune/grid/yaspgrid.hh>
+#endif
+
+#include <dune/geometry/referenceelements.hh>
+
+#include <dune/stuff/common/configuration.hh>
+#include <dune/stuff/common/string.hh>
+#include <dune/stuff/grid/provider/cube.hh>
+#include <dune/stuff/functions/random_ellipsoids_function.hh>
+
+#if HAVE_DUNE_GRID
+
+using namespace Dune;
+using namespace Stuff;
+
+template <class DimDomain>
+class RandomEllipsoidsFunctionTest : public ::testing::Test
+{
+protected:
+  static const size_t dimDomain = DimDomain::value;
+  typedef YaspGrid<dimDomain, EquidistantOffsetCoordinates<double, dimDomain>> GridType;
+  typedef Functions::RandomEllipsoidsFunction<typename GridType::template Codim<0>::Entity, double, dimDomain, double,
+                                              1, 1>
+      FunctionType;
+  typedef Common::FieldVector<double, dimDomain> PointType;
+
+  RandomEllipsoidsFunctionTest()
+    : grid_(Stuff::Grid::Providers::Cube<GridType>(0.0, 1.0, 8).grid_ptr())
+  {
+    ellipsoid_cfg_["ellipsoids.count"]           = "7";
+    ellipsoid_cfg_["ellipsoids.seed"]            = "42";
+    ellipsoid_cfg_["ellipsoids.recursion_depth"] = "1";
+    ellipsoid_cfg_["ellipsoids.children"]        = "2";
+    ellipsoid_cfg_["ellipsoids.min_radius"]      = "0.05";
+    ellipsoid_cfg_["ellipsoids.max_radius"]      = "0.2";
+  }
+
+  ~RandomEllipsoidsFunctionTest() { std::remove("ellipsoids.txt"); }
+
+  static void expect_equal(const typename FunctionType::EllipsoidType& expected,
+                           const typename FunctionType::EllipsoidType& actual)
+  {
+    EXPECT_EQ(expected.center, actual.center);
+    EXPECT_EQ(expected.radii, actual.radii);
+  }
+
+  void expect_equal_values(const FunctionType& expected, const FunctionType& actual) const
+  {
+    for (const auto& entity : Common::entityRange(grid_->leafGridView())) {
+      const auto& reference_element = ReferenceElements<double, dimDomain>::general(entity.type());
+      const auto expected_local = expected.local_function(entity);
+      const auto actual_local   = actual.local_function(entity);
+      for (int cc = 0; cc < reference_element.size(dimDomain); ++cc) {
+        const auto& corner = reference_element.position(cc, dimDomain);
+        EXPECT_EQ(expected_local->evaluate(corner), actual_local->evaluate(corner));
+      }
+      const auto& center = reference_element.position(0, 0);
+      EXPECT_EQ(expected_local->evaluate(center), actual_local->evaluate(center));
+    }
+  } // ... expect_equal_values(...)
+
+  std::shared_ptr<GridType> grid_;
+  Common::Configuration ellipsoid_cfg_;
+}; // class RandomEllipsoidsFunctionTest
+
+typedef testing::Types<Int<2>, Int<3>> DimDomains;
+
+TYPED_TEST_CASE(RandomEllipsoidsFunctionTest, DimDomains);
+TYPED_TEST(RandomEllipsoidsFunctionTest, save_and_load)
+{
+  typedef typename TestFixture::FunctionType FunctionType;
+  typedef typename TestFixture::PointType PointType;
+  const FunctionType function(PointType(0.), PointType(1.), this->ellipsoid_cfg_);
+  ASSERT_TRUE(function.save("random_ellipsoids_test.bin"));
+  const auto loaded =
+      FunctionType::load("random_ellipsoids_test.bin", PointType(0.), PointType(1.), this->ellipsoid_cfg_);
+  std::remove("random_ellipsoids_test.bin");
+  ASSERT_EQ(function.ellipsoids().size(), loaded->ellipsoids().size());
+  for (size_t ii = 0; ii < function.ellipsoids().size(); ++ii)
+    this->expect_equal(function.ellipsoids()[ii], loaded->ellipsoids()[ii]);
+  this->expect_equal_values(function, *loaded);
+}
+
+TYPED_TEST(RandomEllipsoidsFunctionTest, local_evaluation)
+{
+  typedef typename TestFixture::FunctionType FunctionType;
+  typedef typename TestFixture::PointType PointType;
+  static const size_t dimDomain = TestFixture::dimDomain;
+  const FunctionType function(PointType(0.), PointType(1.), this->ellipsoid_cfg_);
+  // the local functions only know the ellipsoids found in the tree, compare them to all ellipsoids
+  size_t num_inside = 0;
+  for (const auto& entity : Common::entityRange(this->grid_->leafGridView())) {
+    const auto& geometry          = entity.geometry();
+    const auto& reference_element = ReferenceElements<double, dimDomain>::general(entity.type());
+    const auto local_function     = function.local_function(entity);
+    std::vector<FieldVector<double, dimDomain>> points;
+    for (int cc = 0; cc < reference_element.size(dimDomain); ++cc)
+      points.push_back(reference_element.position(cc, dimDomain));
+    for (int ff = 0; ff < reference_element.size(1); ++ff)
+      points.push_back(reference_element.position(ff, 1));
+    points.push_back(reference_element.position(0, 0));
+    for (const auto& point : points) {
+      const auto global_point = geometry.global(point);
+      const auto contains     = [&](const typename FunctionType::EllipsoidType& ellipsoid) {
+        return ellipsoid.contains(global_point);
+      };
+      const bool inside = std::any_of(function.ellipsoids().begin(), function.ellipsoids().end(), contains);
+      if (inside)
+        ++num_inside;
+      EXPECT_EQ(inside ? 1. : 0., local_function->evaluate(point)) << "at " << global_point;
+    }
+  }
+  EXPECT_GT(num_inside, size_t(0));
+}
+
+TYPED_TEST(RandomEllipsoidsFunctionTest, family_size)
+{
+  typedef typename TestFixture::FunctionType FunctionType;
+  // a level 0 ellipsoid, two children and four grandchildren
+  EXPECT_EQ(size_t(7), FunctionType::family_size(this->ellipsoid_cfg_));
+  for (size_t depth = 0; depth < 3; ++depth) {
+    for (size_t children = 1; children < 4; ++children) {
+      Common::Configuration cfg         = this->ellipsoid_cfg_;
+      cfg["ellipsoids.recursion_depth"] = Common::toString(depth);
+      cfg["ellipsoids.children"]        = Common::toString(children);
+      const size_t size                 = FunctionType::family_size(cfg);
+      // mark all ellipsoids as not generated, including one past the family
+      typedef typename FunctionType::EllipsoidType EllipsoidType;
+      std::vector<EllipsoidType> ellipsoids(size + 1);
+      for (auto& ellipsoid : ellipsoids)
+        ellipsoid.radii = typename EllipsoidType::DomainType(-1.);
+      FunctionType::generate_family(cfg, 3, ellipsoids.data());
+      for (size_t ii = 0; ii < size; ++ii)
+        EXPECT_GT(ellipsoids[ii].radii[0], 0.) << "depth " << depth << ", children " << children << ", ii " << ii;
+      EXPECT_EQ(-1., ellipsoids[size].radii[0]) << "depth " << depth << ", children " << children;
+    }
+  }
+}
+
+TYPED_TEST(RandomEllipsoidsFunctionTest, families_are_independent)
+{
+  typedef typename TestFixture::FunctionType FunctionType;
+  typedef typename TestFixture::PointType PointType;
+  const FunctionType function(PointType(0.), PointType(1.), this->ellipsoid_cfg_);
+  const size_t num_families = this->ellipsoid_cfg_.template get<size_t>("ellipsoids.count");
+  const size_t size         = FunctionType::family_size(this->ellipsoid_cfg_);
+  ASSERT_EQ(num_families * size, function.ellipsoids().size());
+  // generating the families in reverse order gives the same ellipsoids
+  std::vector<typename FunctionType::EllipsoidType> reversed(num_families * size);
+  for (size_t ii = num_families; ii > 0; --ii)
+    FunctionType::generate_family(this->ellipsoid_cfg_, ii - 1, reversed.data() + (ii - 1) * size);
+  for (size_t ii = 0; ii < reversed.size(); ++ii)
+    this->expect_equal(function.ellipsoids()[ii], reversed[ii]);
+}
+
+#else // HAVE_DUNE_GRID
+
+// no-compile placeholders to mark disabled tests in test-binary output
+TEST(DISABLED_RandomEllipsoidsFunctionTest, save_and_load) {}
+TEST(DISABLED_RandomEllipsoidsFunctionTest, local_evaluation) {}
+TEST(DISABLED_RandomEllipsoidsFunctionTest, family_size) {}
+TEST(DISABLED_RandomEllipsoidsFunctionTest, families_are_independent) {}
+
+#endif // HAVE_DUNE_GRID
@@ -5,7 +5,11 @@
 
 #include "main.hxx"
 
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 #include <memory>
+#include <string>
 
 #include <dune/common/exceptions.hh>
 
@@ -34,6 +38,70 @@
   };
 // TEST_STRUCT_GENERATOR
 
+TEST(Spe10DataTest, shared_and_cached)
+{
+  typedef Dune::Stuff::Functions::Spe10::internal::Data DataType;
+  const std::string filename = "spe10_data_test.dat";
+  {
+    std::ofstream file(filename);
+    for (size_t ii = 0; ii < 100; ++ii)
+      file << 0.5 * ii << "\n";
+  }
+  std::remove(DataType::binary_filename(filename).c_str());
+  {
+    const auto data = DataType::get(filename, 50);
+    ASSERT_EQ(size_t(50), data->size());
+    for (size_t ii = 0; ii < data->size(); ++ii)
+      EXPECT_EQ(0.5 * ii, (*data)[ii]);
+    // the same values are shared
+    EXPECT_EQ(data, DataType::get(filename, 40));
+    EXPECT_EQ(data, DataType::get("./" + filename, 50));
+    // more values require a reload
+    const auto more_data = DataType::get(filename, 100);
+    EXPECT_NE(data, more_data);
+    EXPECT_EQ(0.5 * 99, (*more_data)[99]);
+    EXPECT_THROW(DataType::get(filename, 101), Dune::IOError);
+  }
+  // the binary file is used on its own
+  std::remove(filename.c_str());
+  const auto data = DataType::get(filename, 100);
+  EXPECT_TRUE(data->mapped());
+  EXPECT_EQ(0.5 * 99, (*data)[99]);
+  EXPECT_THROW(DataType::get("spe10_data_test_missing.dat", 1), Dune::Stuff::Exceptions::spe10_data_file_missing);
+  std::remove(DataType::binary_filename(filename).c_str());
+} // Spe10DataTest, shared_and_cached
+
+TEST(Spe10DataTest, truncated_cache)
+{
+  typedef Dune::Stuff::Functions::Spe10::internal::Data DataType;
+  const std::string filename = "spe10_data_test_truncated.dat";
+  {
+    std::ofstream file(filename);
+    for (size_t ii = 0; ii < 100; ++ii)
+      file << 0.5 * ii << "\n";
+  }
+  const std::string cache_filename = DataType::binary_filename(filename);
+  std::remove(cache_filename.c_str());
+  EXPECT_TRUE(DataType::get(filename, 100)->mapped());
+  // simulate a cache which was only partially written
+  std::string contents;
+  {
+    std::ifstream file(cache_filename, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(cache_filename, std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size() / 2));
+  }
+  // the cache is regenerated from the text file instead of failing on mapping
+  const auto data = DataType::get(filename, 100);
+  EXPECT_TRUE(data->mapped());
+  EXPECT_EQ(0.5 * 99, (*data)[99]);
+  EXPECT_TRUE(Dune::Stuff::Common::MappedArray<double>::is_valid(cache_filename, 100));
+  std::remove(filename.c_str());
+  std::remove(cache_filename.c_str());
+} // Spe10DataTest, truncated_cache
+
 #if HAVE_DUNE_GRID
 
 //# include <dune/grid/yaspgrid.hh>
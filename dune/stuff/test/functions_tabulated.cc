@@ -0,0 +1,175 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <cmath>
+
+#if HAVE_DUNE_GRID
+#include <dune/grid/yaspgrid.hh>
+#endif
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/common/float_cmp.hh>
+#include <dune/stuff/grid/provider/cube.hh>
+#include <dune/stuff/functions/constant.hh>
+#include <dune/stuff/functions/global.hh>
+#include <dune/stuff/functions/tabulated.hh>
+
+#include "functions.hh"
+
+#if HAVE_DUNE_GRID
+
+using namespace Dune;
+using namespace Stuff;
+
+template <class DimDomain>
+struct TabulatedTypes
+{
+  typedef YaspGrid<DimDomain::value, EquidistantOffsetCoordinates<double, DimDomain::value>> GridType;
+  typedef typename GridType::template Codim<0>::Entity EntityType;
+  typedef Functions::Tabulated<EntityType, double, DimDomain::value, double, 1, 1> value;
+  typedef GlobalLambdaFunction<EntityType, double, DimDomain::value, double, 1, 1> LambdaType;
+  typedef Functions::Constant<EntityType, double, DimDomain::value, double, 1, 1> ConstantType;
+}; // struct TabulatedTypes
+
+template <class DimDomain>
+class TabulatedTest : public FunctionTest<typename TabulatedTypes<DimDomain>::value>
+{
+protected:
+  typedef TabulatedTypes<DimDomain> Types;
+  typedef typename Types::GridType GridType;
+  typedef typename Types::value TabulatedType;
+  typedef typename Types::LambdaType LambdaType;
+  typedef typename Types::ConstantType ConstantType;
+  typedef typename TabulatedType::DomainType DomainType;
+  typedef typename TabulatedType::RangeType RangeType;
+  typedef typename TabulatedType::NumPointsType NumPointsType;
+
+  TabulatedTest()
+    : grid_(Stuff::Grid::Providers::Cube<GridType>(0.0, 1.0, 4).grid_ptr())
+    , affine_([](DomainType xx) { return RangeType(1.0 + 2.0 * xx[0] - xx[DimDomain::value - 1]); }, 1)
+    , smooth_(
+          [](DomainType xx) { return RangeType(std::sin(3.0 * xx[0]) * std::cos(2.0 * xx[DimDomain::value - 1])); }, 3)
+  {
+  }
+
+  static DomainType point(const size_t ii)
+  {
+    DomainType ret;
+    for (size_t dd = 0; dd < DimDomain::value; ++dd)
+      ret[dd] = std::fmod(0.137 * double(ii + 1) * double(dd + 2), 1.0);
+    return ret;
+  }
+
+  // the largest difference to the tabulated function in some points which are not on the lattice
+  static double max_error(const LambdaType& function, const TabulatedType& tabulated)
+  {
+    double ret = 0;
+    for (size_t ii = 0; ii < 50; ++ii)
+      ret = std::max(ret, std::abs(function.evaluate(point(ii))[0] - tabulated.evaluate(point(ii))[0]));
+    return ret;
+  }
+
+  std::shared_ptr<GridType> grid_;
+  const LambdaType affine_;
+  const LambdaType smooth_;
+}; // class TabulatedTest
+
+typedef testing::Types<Int<1>, Int<2>, Int<3>> DimDomains;
+
+TYPED_TEST_CASE(TabulatedTest, DimDomains);
+TYPED_TEST(TabulatedTest, static_interface_check) { this->static_interface_check(); }
+TYPED_TEST(TabulatedTest, dynamic_interface_check)
+{
+  const typename TestFixture::TabulatedType tabulated(
+      this->affine_, typename TestFixture::DomainType(0), typename TestFixture::DomainType(1),
+      typename TestFixture::NumPointsType(5));
+  this->dynamic_interface_check(tabulated, *(this->grid_));
+}
+TYPED_TEST(TabulatedTest, wrong_input_check)
+{
+  typedef typename TestFixture::TabulatedType TabulatedType;
+  typedef typename TestFixture::DomainType DomainType;
+  typedef typename TestFixture::NumPointsType NumPointsType;
+  EXPECT_THROW(TabulatedType{this->affine_, DomainType(0), DomainType(1), NumPointsType(1)},
+               Exceptions::wrong_input_given);
+  EXPECT_THROW(TabulatedType{this->affine_, DomainType(1), DomainType(0), NumPointsType(5)},
+               Exceptions::wrong_input_given);
+  // the grid does not cover the box
+  EXPECT_THROW(
+      TabulatedType(this->grid_->leafGridView(), this->affine_, DomainType(0), DomainType(2), NumPointsType(5)),
+      Exceptions::wrong_input_given);
+}
+TYPED_TEST(TabulatedTest, multilinear_check)
+{
+  typedef typename TestFixture::TabulatedType TabulatedType;
+  typedef typename TestFixture::DomainType DomainType;
+  typedef typename TestFixture::NumPointsType NumPointsType;
+  // multilinear interpolation is exact for affine functions
+  const TabulatedType tabulated(this->affine_, DomainType(0), DomainType(1), NumPointsType(5));
+  EXPECT_EQ(size_t(std::pow(5, TypeParam::value)), tabulated.values().size());
+  EXPECT_LT(tabulated.max_interpolation_error(), 1e-13);
+  EXPECT_LT(this->max_error(this->affine_, tabulated), 1e-13);
+  // and converges with second order for smooth ones
+  const TabulatedType coarse(this->smooth_, DomainType(0), DomainType(1), NumPointsType(9));
+  const TabulatedType fine(this->smooth_, DomainType(0), DomainType(1), NumPointsType(17));
+  EXPECT_LT(fine.max_interpolation_error(), 0.35 * coarse.max_interpolation_error());
+  EXPECT_LT(this->max_error(this->smooth_, fine), 2e-2);
+}
+TYPED_TEST(TabulatedTest, cubic_check)
+{
+  typedef typename TestFixture::TabulatedType TabulatedType;
+  typedef typename TestFixture::DomainType DomainType;
+  typedef typename TestFixture::NumPointsType NumPointsType;
+  const TabulatedType linear(this->smooth_, DomainType(0), DomainType(1), NumPointsType(17));
+  const TabulatedType cubic(
+      this->smooth_, DomainType(0), DomainType(1), NumPointsType(17), TabulatedType::Interpolation::cubic);
+  EXPECT_LT(cubic.max_interpolation_error(), linear.max_interpolation_error());
+  EXPECT_LT(this->max_error(this->smooth_, cubic), 2.5e-3);
+}
+TYPED_TEST(TabulatedTest, parallel_check)
+{
+  typedef typename TestFixture::TabulatedType TabulatedType;
+  typedef typename TestFixture::DomainType DomainType;
+  typedef typename TestFixture::NumPointsType NumPointsType;
+  const TabulatedType sequential(this->smooth_, DomainType(0), DomainType(1), NumPointsType(9));
+  const TabulatedType parallel(
+      this->smooth_, DomainType(0), DomainType(1), NumPointsType(9), TabulatedType::Interpolation::multilinear, true);
+  EXPECT_EQ(sequential.values(), parallel.values());
+  EXPECT_EQ(sequential.max_interpolation_error(), parallel.max_interpolation_error());
+}
+TYPED_TEST(TabulatedTest, localizable_check)
+{
+  typedef typename TestFixture::TabulatedType TabulatedType;
+  typedef typename TestFixture::DomainType DomainType;
+  typedef typename TestFixture::NumPointsType NumPointsType;
+  // lattice points on element boundaries have to be found as well
+  const TabulatedType from_global(this->smooth_, DomainType(0), DomainType(1), NumPointsType(9));
+  const TabulatedType from_grid(this->grid_->leafGridView(), this->smooth_, DomainType(0), DomainType(1),
+                                NumPointsType(9), TabulatedType::Interpolation::multilinear, true);
+  ASSERT_EQ(from_global.values().size(), from_grid.values().size());
+  for (size_t ii = 0; ii < from_global.values().size(); ++ii)
+    EXPECT_TRUE(Common::FloatCmp::eq(from_global.values()[ii], from_grid.values()[ii]));
+  const typename TestFixture::ConstantType constant(2.0);
+  const TabulatedType tabulated_constant(
+      this->grid_->leafGridView(), constant, DomainType(0.25), DomainType(0.75), NumPointsType(3));
+  EXPECT_EQ(size_t(0), tabulated_constant.order());
+  EXPECT_TRUE(
+      Common::FloatCmp::eq(tabulated_constant.evaluate(DomainType(0.4)), typename TestFixture::RangeType(2.0)));
+}
+
+#else // HAVE_DUNE_GRID
+
+// no-compile placeholders to mark disabled tests in test-binary output
+TEST(DISABLED_TabulatedTest, static_interface_check) {}
+TEST(DISABLED_TabulatedTest, dynamic_interface_check) {}
+TEST(DISABLED_TabulatedTest, wrong_input_check) {}
+TEST(DISABLED_TabulatedTest, multilinear_check) {}
+TEST(DISABLED_TabulatedTest, cubic_check) {}
+TEST(DISABLED_TabulatedTest, parallel_check) {}
+TEST(DISABLED_TabulatedTest, localizable_check) {}
+
+#endif // HAVE_DUNE_GRID
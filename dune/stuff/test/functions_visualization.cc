@@ -0,0 +1,117 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <string>
+#include <vector>
+
+#if HAVE_DUNE_GRID
+#include <dune/grid/yaspgrid.hh>
+#endif
+
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/virtualrefinement.hh>
+
+#include <dune/stuff/common/ranges.hh>
+#include <dune/stuff/grid/provider/cube.hh>
+#include <dune/stuff/functions/expression.hh>
+
+#if HAVE_DUNE_GRID
+
+using namespace Dune;
+using namespace Stuff;
+
+template <class DimDomain>
+class VisualizationAdapterTest : public ::testing::Test
+{
+protected:
+  static const size_t d = DimDomain::value;
+  typedef YaspGrid<d, EquidistantOffsetCoordinates<double, d>> GridType;
+  typedef typename GridType::LeafGridView GridViewType;
+  typedef typename GridType::template Codim<0>::Entity EntityType;
+  typedef Functions::Expression<EntityType, double, d, double, 2> FunctionType;
+  typedef Functions::VisualizationAdapter<GridViewType, 2, 1> AdapterType;
+  typedef typename AdapterType::DomainType DomainType;
+
+  VisualizationAdapterTest()
+    : grid_(Stuff::Grid::Providers::Cube<GridType>(0.0, 1.0, 4).grid_ptr())
+    , function_("x", std::vector<std::string>{"x[0]", "sin(x[0])"}, 2)
+  {
+  }
+
+  // all points, in the order the VTKWriter or the SubsamplingVTKWriter (with level 1) requests them
+  static std::vector<DomainType> points(const EntityType& entity, const bool subsampling)
+  {
+    std::vector<DomainType> ret;
+    if (subsampling) {
+      auto& refinement = buildRefinement<d, double>(entity.type(), entity.type());
+      for (auto it = refinement.vBegin(1); it != refinement.vEnd(1); ++it)
+        ret.push_back(it.coords());
+    } else {
+      const auto& reference_element = ReferenceElements<double, d>::general(entity.type());
+      for (int ii = 0; ii < reference_element.size(d); ++ii)
+        ret.push_back(reference_element.position(ii, d));
+    }
+    return ret;
+  } // ... points(...)
+
+  void check(const AdapterType& adapter, const bool subsampling) const
+  {
+    const AdapterType on_the_fly(function_);
+    EXPECT_EQ(2, adapter.ncomps());
+    EXPECT_EQ(function_.name(), adapter.name());
+    for (const auto& entity : Common::entityRange(grid_->leafGridView()))
+      for (const auto& point : points(entity, subsampling))
+        for (int comp = 0; comp < 2; ++comp)
+          EXPECT_DOUBLE_EQ(on_the_fly.evaluate(comp, entity, point), adapter.evaluate(comp, entity, point));
+    // points which have not been precomputed are evaluated as well
+    const auto entity = *grid_->leafGridView().template begin<0>();
+    const DomainType point(0.3);
+    EXPECT_DOUBLE_EQ(on_the_fly.evaluate(1, entity, point), adapter.evaluate(1, entity, point));
+  } // ... check(...)
+
+  std::shared_ptr<GridType> grid_;
+  const FunctionType function_;
+}; // class VisualizationAdapterTest
+
+typedef testing::Types<Int<1>, Int<2>, Int<3>> DimDomains;
+
+TYPED_TEST_CASE(VisualizationAdapterTest, DimDomains);
+TYPED_TEST(VisualizationAdapterTest, corners_check)
+{
+  const typename TestFixture::AdapterType adapter(this->grid_->leafGridView(), this->function_, -1);
+  this->check(adapter, false);
+}
+TYPED_TEST(VisualizationAdapterTest, subsampling_check)
+{
+  const typename TestFixture::AdapterType adapter(this->grid_->leafGridView(), this->function_, 1, "", true);
+  this->check(adapter, true);
+}
+TYPED_TEST(VisualizationAdapterTest, visualize_check)
+{
+  this->function_.visualize(this->grid_->leafGridView(),
+                            "visualization_adapter_test_" + std::to_string(TypeParam::value));
+  this->function_.visualize(this->grid_->leafGridView(),
+                            "visualization_adapter_test_precomputed_" + std::to_string(TypeParam::value),
+                            true,
+                            VTK::appendedraw,
+                            true);
+  this->function_.visualize(this->grid_->leafGridView(),
+                            "visualization_adapter_test_parallel_" + std::to_string(TypeParam::value),
+                            true,
+                            VTK::appendedraw,
+                            true,
+                            true);
+}
+
+#else // HAVE_DUNE_GRID
+
+// no-compile placeholders to mark disabled tests in test-binary output
+TEST(DISABLED_VisualizationAdapterTest, corners_check) {}
+TEST(DISABLED_VisualizationAdapterTest, subsampling_check) {}
+TEST(DISABLED_VisualizationAdapterTest, visualize_check) {}
+
+#endif // HAVE_DUNE_GRID
@@ -0,0 +1,82 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <vector>
+
+#if HAVE_DUNE_GRID
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/stuff/grid/boundaryinfo.hh>
+#include <dune/stuff/grid/boundaryinfo/precomputed.hh>
+#include <dune/stuff/grid/provider/cube.hh>
+
+using namespace Dune;
+using namespace Stuff;
+
+template <class DimDomain>
+class PrecomputedBoundaryInfoTest : public ::testing::Test
+{
+protected:
+  static const size_t d = DimDomain::value;
+  typedef YaspGrid<d, EquidistantOffsetCoordinates<double, d>> GridType;
+  typedef typename GridType::LeafGridView GridViewType;
+  typedef typename GridViewType::Intersection IntersectionType;
+  typedef Stuff::Grid::BoundaryInfos::NormalBased<IntersectionType> NormalBasedType;
+  typedef typename NormalBasedType::WorldType WorldType;
+
+  PrecomputedBoundaryInfoTest()
+    : grid_(Stuff::Grid::Providers::Cube<GridType>(0.0, 1.0, 4).grid_ptr())
+  {
+  }
+
+  // neumann on the right, dirichlet elsewhere
+  static std::vector<WorldType> neumann_normals()
+  {
+    WorldType normal(0.);
+    normal[0] = 1.;
+    return {normal};
+  }
+
+  std::shared_ptr<GridType> grid_;
+}; // class PrecomputedBoundaryInfoTest
+
+typedef testing::Types<Int<1>, Int<2>, Int<3>> DimDomains;
+
+TYPED_TEST_CASE(PrecomputedBoundaryInfoTest, DimDomains);
+TYPED_TEST(PrecomputedBoundaryInfoTest, matches_wrapped_boundary_info)
+{
+  const auto grid_view = this->grid_->leafGridView();
+  const typename TestFixture::NormalBasedType normal_based(
+      true, std::vector<typename TestFixture::WorldType>(), this->neumann_normals());
+  for (const bool use_tbb : {false, true}) {
+    const auto precomputed = Stuff::Grid::BoundaryInfos::make_precomputed(grid_view, normal_based, use_tbb);
+    EXPECT_TRUE(precomputed.has_dirichlet());
+    EXPECT_TRUE(precomputed.has_neumann());
+    size_t num_neumann = 0;
+    for (const auto& entity : Common::entityRange(grid_view)) {
+      const auto i_it_end = grid_view.iend(entity);
+      for (auto i_it = grid_view.ibegin(entity); i_it != i_it_end; ++i_it) {
+        const auto& intersection = *i_it;
+        EXPECT_EQ(normal_based.dirichlet(intersection), precomputed.dirichlet(intersection));
+        EXPECT_EQ(normal_based.neumann(intersection), precomputed.neumann(intersection));
+        num_neumann += precomputed.neumann(grid_view.indexSet().index(entity), intersection.indexInInside());
+      }
+    }
+    // one face of each of the 4^(d - 1) entities on the right
+    size_t expected = 1;
+    for (size_t dd = 1; dd < TestFixture::d; ++dd)
+      expected *= 4;
+    EXPECT_EQ(expected, num_neumann);
+  }
+}
+
+#else // HAVE_DUNE_GRID
+
+// no-compile placeholders to mark disabled tests in test-binary output
+TEST(DISABLED_PrecomputedBoundaryInfoTest, matches_wrapped_boundary_info) {}
+
+#endif // HAVE_DUNE_GRID
@@ -5,6 +5,8 @@
 
 #include "main.hxx"
 
+#include <cmath>
+
 #if HAVE_DUNE_GRID
 
 #include <dune/stuff/grid/information.hh>
@@ -61,6 +63,35 @@ struct GridInfoTest : public ::testing::Test
     EXPECT_EQ(griddim * 2, maxNumberOfNeighbors(gv));
   }
 
+  void check_statistics()
+  {
+    const auto gv       = grid_prv.grid().leafGridView();
+    const auto entities = size_t(gv.size(0));
+    const auto width    = 1.0 / std::pow(2, level);
+    for (const bool use_tbb : {false, true}) {
+      const auto st = statistics(gv, use_tbb);
+      EXPECT_EQ(entities, st.num_entities);
+      EXPECT_EQ(entities * (2 * griddim), st.num_intersections);
+      EXPECT_EQ(st.num_intersections, st.num_inner_intersections + st.num_boundary_intersections);
+      EXPECT_EQ(size_t(0), st.num_periodic_intersections);
+      EXPECT_DOUBLE_EQ(1.0 / double(entities), st.entity_volume.min());
+      EXPECT_DOUBLE_EQ(1.0 / double(entities), st.entity_volume.max());
+      EXPECT_DOUBLE_EQ(std::sqrt(double(griddim)) * width, st.entity_width.max());
+      EXPECT_DOUBLE_EQ(1.0, st.entity_aspect_ratio.min());
+      EXPECT_DOUBLE_EQ(1.0, st.entity_aspect_ratio.max());
+      EXPECT_DOUBLE_EQ(2.0 * griddim, st.entity_neighbors.min());
+      EXPECT_DOUBLE_EQ(2.0 * griddim, st.entity_neighbors.max());
+      for (auto i : valueRange(griddim)) {
+        EXPECT_DOUBLE_EQ(0.0, st.coord_limits[i].min());
+        EXPECT_DOUBLE_EQ(1.0, st.coord_limits[i].max());
+      }
+      // the merged partial results match a sequential walk
+      const Statistics legacy(st);
+      EXPECT_EQ(Statistics(gv).numberOfBoundaryIntersections, legacy.numberOfBoundaryIntersections);
+      EXPECT_DOUBLE_EQ(Statistics(gv).maxGridWidth, legacy.maxGridWidth);
+    }
+  }
+
   void print(std::ostream& out)
   {
     const auto& gv = grid_prv.grid().leafGridView();
@@ -74,5 +105,9 @@ TYPED_TEST(GridInfoTest, Misc)
   this->check();
   this->print(dev_null);
 }
+TYPED_TEST(GridInfoTest, Statistics)
+{
+  this->check_statistics();
+}
 
 #endif // #if HAVE_DUNE_GRID
@@ -11,9 +11,19 @@
 #if HAVE_ALUGRID
 #include <dune/grid/alugrid.hh>
 #endif
+#include <dune/grid/geometrygrid.hh>
 #include <dune/grid/yaspgrid.hh>
 
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <memory>
+#include <vector>
+
 #include <dune/stuff/common/configuration.hh>
+#include <dune/stuff/common/memory.hh>
+#include <dune/stuff/common/ranges.hh>
 #include <dune/stuff/common/string.hh>
 #include <dune/stuff/common/type_utils.hh>
 #include <dune/stuff/grid/periodicview.hh>
@@ -33,6 +43,77 @@ using namespace Stuff;
 #define ALUSIMPLEXGRIDS ALUGrid<2, 2, simplex, conforming>, ALUGrid<3, 3, simplex, conforming>
 #endif // HAVE_ALUGRID
 
+/**
+ * Compares outside() and indexInOutside() of all boundary intersections of periodic_grid_view with the intersection
+ * found by comparing its center to the centers of all boundary intersections of grid_view: the periodic neighbor lies
+ * on the opposite side of the grid in exactly one periodic direction and has the same coordinates otherwise.
+ */
+template <class PeriodicGridViewType, class GridViewType>
+void check_against_brute_force(const PeriodicGridViewType& periodic_grid_view, const GridViewType& grid_view,
+                               const std::bitset<GridViewType::dimension> periodic_directions)
+{
+  static const size_t dimDomain = GridViewType::dimension;
+  typedef typename GridViewType::template Codim<0>::Geometry::GlobalCoordinate DomainType;
+  typedef typename GridViewType::IndexSet::IndexType IndexType;
+  struct BoundaryFace
+  {
+    IndexType entity_index;
+    int index_in_inside;
+    DomainType center;
+  };
+  const auto& index_set = grid_view.indexSet();
+  std::vector<BoundaryFace> faces;
+  for (const auto& entity : DSC::entityRange(grid_view))
+    for (const auto& intersection : DSC::intersectionRange(grid_view, entity))
+      if (intersection.boundary())
+        faces.push_back({index_set.index(entity), intersection.indexInInside(), intersection.geometry().center()});
+  ASSERT_FALSE(faces.empty());
+  DomainType lower_left  = faces[0].center;
+  DomainType upper_right = faces[0].center;
+  for (const auto& face : faces) {
+    for (size_t ii = 0; ii < dimDomain; ++ii) {
+      lower_left[ii]  = std::min(lower_left[ii], face.center[ii]);
+      upper_right[ii] = std::max(upper_right[ii], face.center[ii]);
+    }
+  }
+  const auto on_opposite_sides = [&](const double left, const double right, const size_t ii) {
+    return (DSC::FloatCmp::eq(left, lower_left[ii]) && DSC::FloatCmp::eq(right, upper_right[ii]))
+           || (DSC::FloatCmp::eq(left, upper_right[ii]) && DSC::FloatCmp::eq(right, lower_left[ii]));
+  };
+  for (const auto& entity : DSC::entityRange(periodic_grid_view)) {
+    for (const auto& intersection : DSC::intersectionRange(periodic_grid_view, entity)) {
+      if (!intersection.boundary())
+        continue;
+      const auto center = intersection.geometry().center();
+      const BoundaryFace* expected = nullptr;
+      size_t num_candidates = 0;
+      for (const auto& face : faces) {
+        size_t num_differing = 0;
+        bool periodic_partner = true;
+        for (size_t ii = 0; ii < dimDomain; ++ii) {
+          if (DSC::FloatCmp::ne(center[ii], face.center[ii])) {
+            ++num_differing;
+            periodic_partner = periodic_partner && periodic_directions[ii]
+                               && on_opposite_sides(center[ii], face.center[ii], ii);
+          }
+        }
+        if (num_differing == 1 && periodic_partner) {
+          expected = &face;
+          ++num_candidates;
+        }
+      }
+      if (expected == nullptr) {
+        EXPECT_FALSE(intersection.neighbor());
+        continue;
+      }
+      EXPECT_EQ(size_t(1), num_candidates);
+      ASSERT_TRUE(intersection.neighbor());
+      EXPECT_EQ(expected->entity_index, index_set.index(intersection.outside()));
+      EXPECT_EQ(expected->index_in_inside, intersection.indexInOutside());
+    }
+  }
+} // ... check_against_brute_force(...)
+
 template <class GridImp>
 struct PeriodicViewTestYaspCube : public testing::Test
 {
@@ -272,6 +353,12 @@ struct PeriodicViewTestYaspCube : public testing::Test
     this->check(hr_non_periodic_grid_view, hyperrectangle_grid_view, is_simplex, 3);
     this->check(hr_partially_periodic_grid_view, hyperrectangle_grid_view, is_simplex, 4);
     this->check(hr_fully_periodic_grid_view, hyperrectangle_grid_view, is_simplex, 5);
+    check_against_brute_force(non_periodic_grid_view, grid_view, std::bitset<dimDomain>());
+    check_against_brute_force(partially_periodic_grid_view, grid_view, std::bitset<dimDomain>(1));
+    check_against_brute_force(fully_periodic_grid_view, grid_view, periodic_directions);
+    check_against_brute_force(hr_non_periodic_grid_view, hyperrectangle_grid_view, std::bitset<dimDomain>());
+    check_against_brute_force(hr_partially_periodic_grid_view, hyperrectangle_grid_view, std::bitset<dimDomain>(1));
+    check_against_brute_force(hr_fully_periodic_grid_view, hyperrectangle_grid_view, periodic_directions);
   } // void checks_for_all_grids(...)
 
   void non_trivial_origin_checks(const bool is_simplex)
@@ -297,6 +384,9 @@ struct PeriodicViewTestYaspCube : public testing::Test
     this->check(non_periodic_grid_view, grid_view, is_simplex, 6);
     this->check(partially_periodic_grid_view, grid_view, is_simplex, 7);
     this->check(fully_periodic_grid_view, grid_view, is_simplex, 8);
+    check_against_brute_force(non_periodic_grid_view, grid_view, std::bitset<dimDomain>());
+    check_against_brute_force(partially_periodic_grid_view, grid_view, std::bitset<dimDomain>(1));
+    check_against_brute_force(fully_periodic_grid_view, grid_view, periodic_directions);
   } // void additional_checks_for_alu(...)
 };  // ... struct PeriodicViewTestYaspCube ...
 
@@ -326,6 +416,146 @@ TYPED_TEST(PeriodicViewTestYaspCube, check_yaspcube)
   this->non_trivial_origin_checks(false);
 }
 
+template <class DimDomain>
+struct PeriodicViewTestGraded : public testing::Test
+{
+  static const size_t dimDomain = DimDomain::value;
+  typedef YaspGrid<DimDomain::value, TensorProductCoordinates<double, DimDomain::value>> GridType;
+  typedef typename GridType::LeafGridView GridViewType;
+  typedef typename Dune::Stuff::Grid::template PeriodicGridView<GridViewType> PeriodicGridViewType;
+  typedef typename GridViewType::template Codim<0>::Geometry::GlobalCoordinate DomainType;
+
+  PeriodicViewTestGraded()
+    : grid_(create_grid())
+    , grid_view_(grid_->leafGridView())
+  {
+  }
+
+  /**
+   * The cells on [-1, 1 - 2^-9] halve their width from left to right in x-direction, the other directions consist of
+   * three cells on [0.5, 2]. The former search for the periodic neighbor, which shifted the center of the intersection
+   * to the opposite side by a hundredth of the inner cell, ended up in the wrong cell on such grids.
+   */
+  static std::unique_ptr<GridType> create_grid()
+  {
+    std::array<std::vector<double>, dimDomain> coordinates;
+    coordinates[0].push_back(-1.);
+    for (size_t ii = 0; ii < num_cells(0); ++ii)
+      coordinates[0].push_back(coordinates[0].back() + std::pow(0.5, ii));
+    for (size_t dd = 1; dd < dimDomain; ++dd)
+      coordinates[dd] = {0.5, 1., 1.5, 2.};
+    return DSC::make_unique<GridType>(coordinates);
+  }
+
+  static size_t num_cells(const size_t dd) { return dd == 0 ? 10 : 3; }
+
+  static DomainType lower_left()
+  {
+    DomainType ret(0.5);
+    ret[0] = -1.;
+    return ret;
+  }
+
+  static DomainType upper_right()
+  {
+    DomainType ret(2.);
+    ret[0] = 1. - std::pow(0.5, 9);
+    return ret;
+  }
+
+  // checks that each periodic intersection is identified with an intersection on the opposite boundary
+  void check_periodic_partners(const std::bitset<dimDomain> periodic_directions) const
+  {
+    const PeriodicGridViewType periodic_grid_view(grid_view_, periodic_directions);
+    size_t expected_periodic_count = 0;
+    for (size_t dd = 0; dd < dimDomain; ++dd) {
+      if (!periodic_directions[dd])
+        continue;
+      size_t faces = 2;
+      for (size_t ii = 0; ii < dimDomain; ++ii)
+        if (ii != dd)
+          faces *= num_cells(ii);
+      expected_periodic_count += faces;
+    }
+    size_t periodic_count = 0;
+    for (const auto& entity : DSC::entityRange(periodic_grid_view)) {
+      for (const auto& intersection : DSC::intersectionRange(periodic_grid_view, entity)) {
+        if (!(intersection.boundary() && intersection.neighbor()))
+          continue;
+        ++periodic_count;
+        const auto outside = intersection.outside();
+        size_t num_found = 0;
+        for (const auto& outside_intersection : DSC::intersectionRange(grid_view_, outside)) {
+          if (outside_intersection.indexInInside() != intersection.indexInOutside())
+            continue;
+          ++num_found;
+          EXPECT_TRUE(outside_intersection.boundary());
+          const auto center         = intersection.geometry().center();
+          const auto outside_center = outside_intersection.geometry().center();
+          size_t num_differing = 0;
+          for (size_t ii = 0; ii < dimDomain; ++ii) {
+            if (DSC::FloatCmp::eq(center[ii], outside_center[ii]))
+              continue;
+            ++num_differing;
+            EXPECT_TRUE(periodic_directions[ii]);
+            EXPECT_TRUE((DSC::FloatCmp::eq(center[ii], lower_left()[ii])
+                         && DSC::FloatCmp::eq(outside_center[ii], upper_right()[ii]))
+                        || (DSC::FloatCmp::eq(center[ii], upper_right()[ii])
+                            && DSC::FloatCmp::eq(outside_center[ii], lower_left()[ii])));
+          }
+          EXPECT_EQ(size_t(1), num_differing);
+        }
+        EXPECT_EQ(size_t(1), num_found);
+      }
+    }
+    EXPECT_EQ(expected_periodic_count, periodic_count);
+    check_against_brute_force(periodic_grid_view, grid_view_, periodic_directions);
+  } // ... check_periodic_partners(...)
+
+  std::unique_ptr<GridType> grid_;
+  const GridViewType grid_view_;
+}; // struct PeriodicViewTestGraded
+
+typedef testing::Types<Int<1>, Int<2>, Int<3>> DimDomains;
+
+TYPED_TEST_CASE(PeriodicViewTestGraded, DimDomains);
+TYPED_TEST(PeriodicViewTestGraded, check_graded)
+{
+  std::bitset<TestFixture::dimDomain> periodic_directions;
+  periodic_directions[0] = 1;
+  this->check_periodic_partners(periodic_directions);
+  periodic_directions.set();
+  this->check_periodic_partners(periodic_directions);
+}
+
+//! shears the unit square, such that the intersections on opposite boundaries do not match
+class ShearedCoordinates : public AnalyticalCoordFunction<double, 2, 2, ShearedCoordinates>
+{
+public:
+  void evaluate(const FieldVector<double, 2>& x, FieldVector<double, 2>& y) const
+  {
+    y[0] = x[0];
+    y[1] = x[1] * (1. + 0.5 * x[0]);
+  }
+}; // class ShearedCoordinates
+
+TEST(PeriodicViewTestMismatch, throws_on_mismatch)
+{
+  typedef YaspGrid<2, EquidistantOffsetCoordinates<double, 2>> HostGridType;
+  typedef GeometryGrid<HostGridType, ShearedCoordinates> GridType;
+  typedef Dune::Stuff::Grid::PeriodicGridView<GridType::LeafGridView> PeriodicGridViewType;
+  const auto host_grid = Dune::Stuff::Grid::Providers::Cube<HostGridType>(0.0, 1.0, 4).grid_ptr();
+  ShearedCoordinates coordinates;
+  GridType grid(*host_grid, coordinates);
+  const auto grid_view = grid.leafGridView();
+  // the centers on the left and on the right boundary differ in y-direction
+  EXPECT_THROW(PeriodicGridViewType(grid_view, std::bitset<2>("01")), InvalidStateException);
+  // the top boundary only consists of the rightmost intersection (the others are lower), the bottom one of four
+  EXPECT_THROW(PeriodicGridViewType(grid_view, std::bitset<2>("10")), InvalidStateException);
+  // nothing has to match without periodic directions
+  EXPECT_NO_THROW(PeriodicGridViewType(grid_view, std::bitset<2>()));
+} // PeriodicViewTestMismatch, throws_on_mismatch
+
 #if HAVE_ALUGRID
 
 typedef testing::Types<ALUCUBEGRIDS> ALUCubeGridTypes;
@@ -355,5 +585,7 @@ TEST(DISABLED_PeriodicViewTestALUSimplex, check_alusimplex) {}
 #else  // HAVE_DUNE_GRID
 
 TEST(DISABLED_PeriodicViewTestYaspCube, check_yaspcube) {}
+TEST(DISABLED_PeriodicViewTestGraded, check_graded) {}
+TEST(DISABLED_PeriodicViewTestMismatch, throws_on_mismatch) {}
 
 #endif // HAVE_DUNE_GRID
@@ -0,0 +1,68 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <cstdio>
+#include <vector>
+
+#include <dune/stuff/common/ranges.hh>
+#include <dune/stuff/grid/provider/checkpoint.hh>
+#include <dune/stuff/grid/provider/cube.hh>
+
+#include "grid_provider.hh"
+
+#if HAVE_DUNE_GRID
+
+template< class GridType >
+struct CheckpointGridProvider
+  : public ::testing::Test
+{
+  typedef Dune::Stuff::Grid::Providers::Cube< GridType > CubeType;
+  typedef Dune::Stuff::Grid::Providers::Checkpoint< GridType > CheckpointType;
+};
+
+
+typedef testing::Types< YASPGRIDS > GridTypes;
+
+TYPED_TEST_CASE(CheckpointGridProvider, GridTypes);
+TYPED_TEST(CheckpointGridProvider, restores_refined_grid)
+{
+  const typename TestFixture::CubeType cube(0., 1., 2, 2);
+  cube.checkpoint("checkpoint_test");
+  auto config = TestFixture::CheckpointType::default_config();
+  config["filename"] = "checkpoint_test";
+  const auto restored = TestFixture::CheckpointType::create(config);
+  EXPECT_EQ(cube.grid().maxLevel(), restored->grid().maxLevel());
+  const auto expected_view = cube.leaf_view();
+  const auto restored_view = restored->leaf_view();
+  ASSERT_EQ(expected_view.size(0), restored_view.size(0));
+  // the entities are restored in the same order
+  std::vector< typename TestFixture::CubeType::DomainType > expected_centers(expected_view.size(0));
+  for (const auto& entity : Dune::Stuff::Common::entityRange(expected_view))
+    expected_centers[expected_view.indexSet().index(entity)] = entity.geometry().center();
+  for (const auto& entity : Dune::Stuff::Common::entityRange(restored_view)) {
+    const auto center = entity.geometry().center();
+    const auto& expected = expected_centers[restored_view.indexSet().index(entity)];
+    for (size_t dd = 0; dd < center.size(); ++dd)
+      EXPECT_DOUBLE_EQ(expected[dd], center[dd]);
+  }
+  const auto& comm = cube.grid().comm();
+  std::remove(Dune::Stuff::Grid::internal::checkpoint_filename("checkpoint_test", comm.rank(), comm.size()).c_str());
+}
+TYPED_TEST(CheckpointGridProvider, throws_without_checkpoint)
+{
+  auto config = TestFixture::CheckpointType::default_config();
+  config["filename"] = "checkpoint_test_missing";
+  EXPECT_THROW(TestFixture::CheckpointType::create(config), Dune::IOError);
+}
+
+
+#else // HAVE_DUNE_GRID
+
+TEST(DISABLED_CheckpointGridProvider, restores_refined_grid) {}
+TEST(DISABLED_CheckpointGridProvider, throws_without_checkpoint) {}
+
+#endif // HAVE_DUNE_GRID
@@ -41,12 +41,25 @@ TYPED_TEST(GmshGridProvider, fulfills_non_const_interface)
 {
   this->non_const_interface();
 }
+TYPED_TEST(GmshGridProvider, is_distributable)
+{
+  typedef Dune::Stuff::Grid::Providers::Gmsh< TypeParam > ProviderType;
+  const auto filename = ProviderType::default_config().template get< std::string >("filename");
+  const ProviderType full(filename);
+  const ProviderType distributed(filename, true);
+  // the distributed grid is always built via the factory and loadBalance(), each rank only holds its part, which is
+  // the whole grid in a sequential run
+  EXPECT_GE(full.grid().size(0), distributed.grid().size(0));
+  if (distributed.grid().comm().size() == 1)
+    EXPECT_EQ(full.grid().size(0), distributed.grid().size(0));
+}
 
 #else // HAVE_DUNE_GRID && HAVE_ALUGRID
 
 TEST(DISABLED_GmshGridProvider, is_default_creatable) {}
 TEST(DISABLED_GmshGridProvider, fulfills_const_interface) {}
 TEST(DISABLED_GmshGridProvider, is_visualizable) {}
+TEST(DISABLED_GmshGridProvider, is_distributable) {}
 
 #endif // HAVE_DUNE_GRID && HAVE_ALUGRID
 
@@ -0,0 +1,122 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/stuff/playground/grid/provider/starcd.hh>
+
+using namespace Dune::Stuff;
+
+typedef internal::StarCDReader<3> ReaderType;
+
+// n hexahedra in a row, every other one given as a prism, with zeros in between the vertex indices
+static void write_mesh(const std::string& prefix, const size_t n)
+{
+  std::ofstream vertices(prefix + ".vrt");
+  vertices << "PROSTAR_VERTEX\n" << 4 * (n + 1) << " header\n";
+  for (size_t ii = 0; ii <= n; ++ii)
+    for (size_t jj = 0; jj < 4; ++jj)
+      vertices << 4 * ii + jj + 1 << " " << 0.5 * ii << " " << jj % 2 << " " << jj / 2 << "\n";
+  std::ofstream cells(prefix + ".cel");
+  cells << "PROSTAR_CELL\nheader\n";
+  for (size_t ii = 0; ii < n; ++ii) {
+    cells << ii + 1 << " 1 1\n" << ii + 1 << " 0";
+    for (size_t jj = 0; jj < (ii % 2 ? 6 : 8); ++jj)
+      cells << " " << 4 * ii + jj + 1;
+    cells << "\n";
+  }
+} // ... write_mesh(...)
+
+TEST(StarCDReaderTest, read)
+{
+  write_mesh("starcd_test", 100);
+  const auto vertices = ReaderType::read_vertices("starcd_test.vrt");
+  ASSERT_EQ(size_t(3 * 4 * 101), vertices.size());
+  EXPECT_EQ(50., vertices[3 * 4 * 100]);
+  EXPECT_EQ(1., vertices[3 * 4 * 100 + 3 * 3 + 2]);
+  const auto cells = ReaderType::read_cells("starcd_test.cel");
+  ASSERT_EQ(size_t(100 * ReaderType::cell_stride), cells.size());
+  // the cubes are renumbered for dune
+  EXPECT_EQ(std::vector<unsigned int>({8, 0, 1, 3, 2, 4, 5, 7, 6}),
+            std::vector<unsigned int>(cells.begin(), cells.begin() + ReaderType::cell_stride));
+  EXPECT_EQ(std::vector<unsigned int>({6, 4, 5, 6, 7, 8, 9, 0, 0}),
+            std::vector<unsigned int>(cells.begin() + ReaderType::cell_stride,
+                                      cells.begin() + 2 * ReaderType::cell_stride));
+  // the result does not depend on the number of chunks
+  EXPECT_EQ(vertices, ReaderType::read_vertices("starcd_test.vrt", true));
+  EXPECT_EQ(cells, ReaderType::read_cells("starcd_test.cel", true));
+  std::remove("starcd_test.vrt");
+  std::remove("starcd_test.cel");
+} // StarCDReaderTest, read
+
+TEST(StarCDReaderTest, invalid_files)
+{
+  EXPECT_THROW(ReaderType::read_vertices("starcd_test_missing.vrt"), Dune::IOError);
+  std::ofstream("starcd_test_invalid.cel") << "PROSTAR_CELL\nheader\n1 1\n1 1 2 3 4\n";
+  EXPECT_THROW(ReaderType::read_cells("starcd_test_invalid.cel"), Dune::IOError);
+  std::ofstream("starcd_test_invalid.cel") << "PROSTAR_CELL\nheader\n1 1\n";
+  EXPECT_THROW(ReaderType::read_cells("starcd_test_invalid.cel"), Dune::IOError);
+  std::ofstream("starcd_test_invalid.vrt") << "PROSTAR_VERTEX\nheader\n1 0.5 1\n";
+  EXPECT_THROW(ReaderType::read_vertices("starcd_test_invalid.vrt"), Dune::IOError);
+  std::remove("starcd_test_invalid.cel");
+  std::remove("starcd_test_invalid.vrt");
+} // StarCDReaderTest, invalid_files
+
+TEST(StarCDReaderTest, cache)
+{
+  write_mesh("starcd_test_cached", 10);
+  const auto parse = [](const std::string& filename) { return ReaderType::read_vertices(filename); };
+  std::remove("starcd_test_cached.vrt.bin");
+  const internal::StarCDValues<double> parsed("starcd_test_cached.vrt", "test.v1", true, parse);
+  EXPECT_FALSE(parsed.mapped());
+  // the cache is used from now on, even without the text file
+  std::remove("starcd_test_cached.vrt");
+  const internal::StarCDValues<double> cached("starcd_test_cached.vrt", "test.v1", true, parse);
+  EXPECT_TRUE(cached.mapped());
+  ASSERT_EQ(parsed.size(), cached.size());
+  EXPECT_EQ(std::vector<double>(parsed.data(), parsed.data() + parsed.size()),
+            std::vector<double>(cached.data(), cached.data() + cached.size()));
+  // but not if the tag does not match
+  EXPECT_THROW(internal::StarCDValues<double>("starcd_test_cached.vrt", "test.v2", true, parse), Dune::IOError);
+  std::remove("starcd_test_cached.vrt.bin");
+  std::remove("starcd_test_cached.cel");
+} // StarCDReaderTest, cache
+
+TEST(StarCDReaderTest, truncated_cache)
+{
+  write_mesh("starcd_test_truncated", 10);
+  const auto parse = [](const std::string& filename) { return ReaderType::read_vertices(filename); };
+  std::remove("starcd_test_truncated.vrt.bin");
+  const internal::StarCDValues<double> parsed("starcd_test_truncated.vrt", "test.v1", true, parse);
+  const std::vector<double> expected(parsed.data(), parsed.data() + parsed.size());
+  // simulate a cache which was only partially written
+  std::string contents;
+  {
+    std::ifstream file("starcd_test_truncated.vrt.bin", std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file("starcd_test_truncated.vrt.bin", std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size() / 2));
+  }
+  // the mesh is parsed again and the cache is rewritten
+  const internal::StarCDValues<double> reparsed("starcd_test_truncated.vrt", "test.v1", true, parse);
+  EXPECT_FALSE(reparsed.mapped());
+  EXPECT_EQ(expected, std::vector<double>(reparsed.data(), reparsed.data() + reparsed.size()));
+  const internal::StarCDValues<double> cached("starcd_test_truncated.vrt", "test.v1", true, parse);
+  EXPECT_TRUE(cached.mapped());
+  EXPECT_EQ(expected, std::vector<double>(cached.data(), cached.data() + cached.size()));
+  std::remove("starcd_test_truncated.vrt");
+  std::remove("starcd_test_truncated.vrt.bin");
+  std::remove("starcd_test_truncated.cel");
+} // StarCDReaderTest, truncated_cache
@@ -0,0 +1,152 @@
+// This file is part of the dune-stuff project:
+//   https://github.com/wwu-numerik/dune-stuff
+// Copyright holders: Rene Milk, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "main.hxx"
+
+#include <vector>
+
+#if HAVE_DUNE_GRID
+#include <dune/grid/yaspgrid.hh>
+#endif
+
+#include <dune/stuff/grid/provider/cube.hh>
+#include <dune/stuff/grid/search.hh>
+
+#if HAVE_DUNE_GRID
+
+using namespace Dune;
+using namespace Stuff;
+
+template <class DimDomain>
+class EntitySearchTest : public ::testing::Test
+{
+protected:
+  static const size_t d = DimDomain::value;
+  typedef YaspGrid<d, EquidistantOffsetCoordinates<double, d>> GridType;
+  typedef typename GridType::LeafGridView GridViewType;
+  typedef typename GridType::template Codim<0>::Entity::Geometry::GlobalCoordinate DomainType;
+
+  EntitySearchTest()
+    : grid_(Stuff::Grid::Providers::Cube<GridType>(0.0, 1.0, 5).grid_ptr())
+  {
+  }
+
+  //! the centers of all entities, followed by a point outside of the grid
+  std::vector<DomainType> points() const
+  {
+    std::vector<DomainType> ret;
+    for (const auto& entity : Common::entityRange(grid_->leafGridView()))
+      ret.push_back(entity.geometry().center());
+    ret.push_back(DomainType(1.5));
+    return ret;
+  }
+
+  template <class LocationVectorType>
+  void check_locations(const LocationVectorType& locations) const
+  {
+    const auto grid_view = grid_->leafGridView();
+    ASSERT_EQ(size_t(grid_view.size(0)) + 1, locations.size());
+    size_t ii = 0;
+    for (const auto& entity : Common::entityRange(grid_view)) {
+      const auto& location = locations[ii++];
+      ASSERT_TRUE(location.found);
+      EXPECT_EQ(grid_view.indexSet().index(entity), grid_view.indexSet().index(grid_->entity(location.seed)));
+      for (size_t dd = 0; dd < d; ++dd)
+        EXPECT_DOUBLE_EQ(0.5, location.local[dd]);
+    }
+    EXPECT_FALSE(locations.back().found);
+  } // ... check_locations(...)
+
+  std::shared_ptr<GridType> grid_;
+}; // class EntitySearchTest
+
+typedef testing::Types<Int<1>, Int<2>, Int<3>> DimDomains;
+
+TYPED_TEST_CASE(EntitySearchTest, DimDomains);
+TYPED_TEST(EntitySearchTest, bounding_box_search)
+{
+  const auto grid_view = this->grid_->leafGridView();
+  const auto search    = Stuff::Grid::make_entity_bounding_box_search(grid_view);
+  const auto points    = this->points();
+  this->check_locations(search.locate(points));
+  // the search may be reused and gives the same results in parallel
+  const auto parallel_locations = search.locate(points, true);
+  this->check_locations(parallel_locations);
+  // compatible to the other searches
+  const auto entities = search(points);
+  ASSERT_EQ(points.size(), entities.size());
+  for (size_t ii = 0; ii + 1 < points.size(); ++ii) {
+    ASSERT_NE(nullptr, entities[ii]);
+    EXPECT_EQ(grid_view.indexSet().index(this->grid_->entity(parallel_locations[ii].seed)),
+              grid_view.indexSet().index(*entities[ii]));
+  }
+  EXPECT_EQ(nullptr, entities.back());
+}
+TYPED_TEST(EntitySearchTest, structured_search)
+{
+  const auto grid_view = this->grid_->leafGridView();
+  const auto search    = Stuff::Grid::make_entity_structured_search(grid_view);
+  for (size_t dd = 0; dd < TestFixture::d; ++dd) {
+    EXPECT_DOUBLE_EQ(0., search.lower_left()[dd]);
+    EXPECT_DOUBLE_EQ(1., search.upper_right()[dd]);
+    EXPECT_EQ(size_t(5), search.num_elements()[dd]);
+  }
+  auto points = this->points();
+  this->check_locations(search.locate(points));
+  this->check_locations(search.locate(points, true));
+  // points on the boundary and on faces between entities
+  points = {typename TestFixture::DomainType(0.), typename TestFixture::DomainType(1.),
+            typename TestFixture::DomainType(0.4), typename TestFixture::DomainType(0.55)};
+  const auto locations = search.locate(points);
+  const auto expected  = Stuff::Grid::make_entity_bounding_box_search(grid_view).locate(points);
+  for (size_t ii = 0; ii < points.size(); ++ii) {
+    ASSERT_TRUE(locations[ii].found);
+    const auto entity = this->grid_->entity(locations[ii].seed);
+    EXPECT_TRUE(DSG::reference_element(entity).checkInside(locations[ii].local));
+    const auto global = entity.geometry().global(locations[ii].local);
+    for (size_t dd = 0; dd < TestFixture::d; ++dd)
+      EXPECT_NEAR(points[ii][dd], global[dd], 1e-14);
+    if (ii == 3)
+      EXPECT_EQ(grid_view.indexSet().index(this->grid_->entity(expected[ii].seed)), grid_view.indexSet().index(entity));
+  }
+}
+TYPED_TEST(EntitySearchTest, hierarchic_search)
+{
+  this->grid_->globalRefine(2);
+  const auto grid_view = this->grid_->leafGridView();
+  const auto points    = this->points();
+  for (const int start_level : {0, 1}) {
+    const auto search = Stuff::Grid::make_entity_hierarchic_search(grid_view, start_level);
+    this->check_locations(search.locate(points));
+    this->check_locations(search.locate(points, true));
+  }
+  // arbitrary points in the interior of the entities end up where the bounding box search finds them
+  std::vector<typename TestFixture::DomainType> interior_points;
+  for (const auto& entity : Common::entityRange(grid_view))
+    interior_points.push_back(entity.geometry().global(typename TestFixture::DomainType(0.3)));
+  const auto expected = Stuff::Grid::make_entity_bounding_box_search(grid_view).locate(interior_points);
+  const auto actual   = Stuff::Grid::make_entity_hierarchic_search(grid_view).locate(interior_points, true);
+  for (size_t ii = 0; ii < interior_points.size(); ++ii) {
+    ASSERT_TRUE(actual[ii].found);
+    EXPECT_EQ(grid_view.indexSet().index(this->grid_->entity(expected[ii].seed)),
+              grid_view.indexSet().index(this->grid_->entity(actual[ii].seed)));
+  }
+  // the entities of a coarser view are found as well
+  const auto level_view = this->grid_->levelGridView(1);
+  const auto locations  = Stuff::Grid::make_entity_hierarchic_search(level_view).locate(points);
+  for (size_t ii = 0; ii + 1 < points.size(); ++ii) {
+    ASSERT_TRUE(locations[ii].found);
+    EXPECT_EQ(1, this->grid_->entity(locations[ii].seed).level());
+  }
+}
+
+#else // HAVE_DUNE_GRID
+
+// no-compile placeholders to mark disabled tests in test-binary output
+TEST(DISABLED_EntitySearchTest, bounding_box_search) {}
+TEST(DISABLED_EntitySearchTest, structured_search) {}
+TEST(DISABLED_EntitySearchTest, hierarchic_search) {}
+
+#endif // HAVE_DUNE_GRID